@@ -0,0 +1,190 @@
+# Converts assets/icons/*.png into src/asset_data.{h,cpp}: palette + RLE
+# streams decoded by src/asset.cpp (see asset.h for the format).
+# Runs as a PlatformIO pre-build script and skips the work when the
+# output is newer than every PNG; `python build_assets.py` forces it.
+import os
+import struct
+import sys
+import zlib
+
+ROOT = os.path.dirname(os.path.abspath(__file__)) if "__file__" in globals() else os.getcwd()
+ICON_DIR = os.path.join(ROOT, "assets", "icons")
+OUT_H = os.path.join(ROOT, "src", "asset_data.h")
+OUT_CPP = os.path.join(ROOT, "src", "asset_data.cpp")
+
+ALPHA_CUTOFF = 128  # pixels below this alpha are transparent (index 0)
+
+
+# ------------------------------------------------------------
+# Minimal PNG reader: 8-bit grey/RGB/palette/RGBA, not interlaced
+# ------------------------------------------------------------
+def read_png(path):
+    data = open(path, "rb").read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    pos, idat, plte, trns = 8, b"", None, None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            w, h, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            plte = body
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+    if depth != 8 or interlace:
+        raise ValueError("%s: only 8-bit, non-interlaced PNGs" % path)
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    raw = zlib.decompress(idat)
+    stride = w * channels
+    rows, prev, p = [], bytearray(stride), 0
+    for _ in range(h):
+        ftype, line = raw[p], bytearray(raw[p + 1:p + 1 + stride])
+        p += 1 + stride
+        for i in range(stride):
+            a = line[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif ftype == 4:
+                pa, pb, pc = abs(b - c), abs(a - c), abs(a + b - 2 * c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        rows.append(line)
+        prev = line
+
+    pixels = []  # (r, g, b, a)
+    for line in rows:
+        for x in range(w):
+            px = line[x * channels:(x + 1) * channels]
+            if ctype == 0:
+                pixels.append((px[0], px[0], px[0], 255))
+            elif ctype == 4:
+                pixels.append((px[0], px[0], px[0], px[1]))
+            elif ctype == 2:
+                pixels.append((px[0], px[1], px[2], 255))
+            elif ctype == 6:
+                pixels.append(tuple(px))
+            else:
+                i = px[0]
+                alpha = trns[i] if trns and i < len(trns) else 255
+                pixels.append((plte[i * 3], plte[i * 3 + 1], plte[i * 3 + 2], alpha))
+    return w, h, pixels
+
+
+# ------------------------------------------------------------
+# Encoder
+# ------------------------------------------------------------
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def encode(w, h, pixels):
+    colors = [None if a < ALPHA_CUTOFF else rgb565(r, g, b) for r, g, b, a in pixels]
+    counts = {}
+    for c in colors:
+        if c is not None:
+            counts[c] = counts.get(c, 0) + 1
+    # Most frequent colours first so they fit the 4-bit short runs
+    palette = sorted(counts, key=lambda c: -counts[c])
+    if len(palette) > 255:
+        raise ValueError("more than 255 colours after RGB565 rounding")
+    index = {c: i + 1 for i, c in enumerate(palette)}  # 0 = transparent
+    idx = [0 if c is None else index[c] for c in colors]
+
+    out = bytearray()
+    i = 0
+    while i < len(idx):
+        run = 1
+        while i + run < len(idx) and idx[i + run] == idx[i] and run < 16384:
+            run += 1
+        v = idx[i]
+        if run <= 8 and v < 16:
+            out.append(((run - 1) << 4) | v)
+        elif run <= 64:
+            out += bytes([0x80 | (run - 1), v])
+        else:
+            out += bytes([0xC0 | ((run - 1) >> 8), (run - 1) & 0xFF, v])
+        i += run
+    return palette, out
+
+
+# ------------------------------------------------------------
+def wrap(items, per_line):
+    lines = [", ".join(items[k:k + per_line]) for k in range(0, len(items), per_line)]
+    return "    " + ",\n    ".join(lines) + "};\n"
+
+
+def c_name(path):
+    return os.path.splitext(os.path.basename(path))[0].upper()
+
+
+def build():
+    pngs = sorted(f for f in os.listdir(ICON_DIR) if f.endswith(".png"))
+    entries = []
+    for f in pngs:
+        w, h, pixels = read_png(os.path.join(ICON_DIR, f))
+        palette, data = encode(w, h, pixels)
+        entries.append((c_name(f), w, h, palette, data))
+
+    with open(OUT_H, "w", newline="\n") as o:
+        o.write("#pragma once\n// Generated by build_assets.py from assets/icons — do not edit\n")
+        o.write('#include "asset.h"\n\n')
+        for name, *_ in entries:
+            o.write("extern const Asset ICON_%s;\n" % name)
+        o.write("\n#define ASSET_COUNT %d\n" % len(entries))
+        o.write("extern const Asset *const assetTable[ASSET_COUNT];\n")
+        o.write("extern const char *const assetNames[ASSET_COUNT];\n")
+
+    raw_total = packed_total = 0
+    with open(OUT_CPP, "w", newline="\n") as o:
+        o.write("// Generated by build_assets.py from assets/icons — do not edit\n")
+        o.write('#include "asset_data.h"\n')
+        for name, w, h, palette, data in entries:
+            raw_total += w * h * 2
+            packed_total += len(data) + len(palette) * 2
+            o.write("\n// %dx%d, %d colours, %d B (raw %d B)\n"
+                    % (w, h, len(palette), len(data) + len(palette) * 2, w * h * 2))
+            o.write("static const uint16_t %s_pal[] = {\n" % name.lower())
+            o.write(wrap(["0x0000"] + ["0x%04X" % c for c in palette], 8))
+            o.write("static const uint8_t %s_data[] = {\n" % name.lower())
+            o.write(wrap(["0x%02X" % b for b in data], 12))
+            lower = name.lower()
+            o.write("const Asset ICON_%s = {\n    %d, %d, %d, %s_pal, %s_data, sizeof(%s_data)};\n"
+                    % (name, w, h, len(palette) + 1, lower, lower, lower))
+        o.write("\nconst Asset *const assetTable[ASSET_COUNT] = {\n")
+        for name, *_ in entries:
+            o.write("    &ICON_%s,\n" % name)
+        o.write("};\nconst char *const assetNames[ASSET_COUNT] = {\n")
+        for name, *_ in entries:
+            o.write('    "%s",\n' % name.lower())
+        o.write("};\n")
+    print("[assets] %d icons: %d B packed, %d B as RGB565"
+          % (len(entries), packed_total, raw_total))
+
+
+def stale():
+    if not os.path.exists(OUT_CPP) or not os.path.exists(OUT_H):
+        return True
+    built = min(os.path.getmtime(OUT_CPP), os.path.getmtime(OUT_H))
+    sources = [os.path.join(ICON_DIR, f) for f in os.listdir(ICON_DIR)]
+    sources.append(os.path.join(ROOT, "build_assets.py"))
+    return any(os.path.getmtime(s) > built for s in sources)
+
+
+try:
+    Import("env")  # PlatformIO pre-build hook
+    if stale():
+        build()
+except NameError:
+    if __name__ == "__main__":
+        build()
+        sys.exit(0)
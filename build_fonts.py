@@ -0,0 +1,239 @@
+# Subsets the GFX fonts the UI draws down to the codepoints it can show,
+# writing src/font_data.{h,cpp}. Codepoints come from the string
+# literals in the UI sources (the per-language tables in ui_strings.cpp
+# included) plus, per font, the characters runtime text can add.
+# Runs as a PlatformIO pre-build script next to build_assets.py and skips
+# the work when the output is up to date; `python build_fonts.py` forces
+# it. A font whose source header is not found keeps the library font.
+import glob
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__)) if "__file__" in globals() else os.getcwd()
+OUT_H = os.path.join(ROOT, "src", "font_data.h")
+OUT_CPP = os.path.join(ROOT, "src", "font_data.cpp")
+
+# Files whose string literals are UI text
+UI_SOURCES = ["src/ui_manager.cpp", "src/ui_strings.cpp", "src/scheduler.cpp"]
+
+# Where source GFX font headers are looked for, in order
+FONT_DIRS = [
+    "include/fonts",
+    "lib/fonts",
+    ".pio/libdeps/*/LovyanGFX/src/lgfx/Fonts/GFXFF",
+]
+
+ASCII = "".join(chr(c) for c in range(0x20, 0x7F))
+
+# (source font, emitted symbol, macro, include UI literals, extra text)
+# SSIDs and passwords are arbitrary ASCII, so the text faces keep it all;
+# the clock face only ever shows digits.
+FONTS = [
+    ("FreeSansBold24pt7b", "clockFont", "FONT_CLOCK", False, "0123456789:"),
+    ("thaiFont14", "thaiFont14", "FONT_TH14", True, ASCII),
+    ("thaiFont16", "thaiFont16", "FONT_TH16", True, ASCII),
+    ("thaiFont24", "thaiFont24", "FONT_TH24", True, ASCII),
+]
+
+# Unused codepoints between two used ones are filled with empty glyphs
+# when the gap is at most this wide: an empty glyph costs 8 bytes, a new
+# range 6 bytes plus a step in every lookup.
+RANGE_GAP = 4
+
+
+# ------------------------------------------------------------
+# UI text
+# ------------------------------------------------------------
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+FORMAT = re.compile(r"%[-+ 0#]*\d*(?:\.\d+)?[hl]*[diuxXcsf%]")
+
+
+def ui_codepoints():
+    cps = set()
+    for rel in UI_SOURCES:
+        for line in open(os.path.join(ROOT, rel), encoding="utf-8"):
+            s = line.strip()
+            if s.startswith("#include") or "Serial." in s or "consoleRegister" in s:
+                continue
+            for lit in LITERAL.findall(s):
+                lit = FORMAT.sub("", lit).replace("\\n", "").replace('\\"', '"')
+                cps.update(ord(ch) for ch in lit if ord(ch) >= 0x20)
+    cps.update(ord(ch) for ch in "0123456789")  # every %d
+    return cps
+
+
+# ------------------------------------------------------------
+# Adafruit GFX / LovyanGFX font header reader
+# ------------------------------------------------------------
+def find_source(name):
+    for pattern in FONT_DIRS:
+        for d in sorted(glob.glob(os.path.join(ROOT, pattern))):
+            path = os.path.join(d, name + ".h")
+            if os.path.exists(path):
+                return path
+    return None
+
+
+def array_body(text, suffix):
+    m = re.search(r"\w*%s\s*\[\s*\]\s*(?:PROGMEM\s*)?=\s*\{" % suffix, text)
+    if not m:
+        return None
+    depth, i = 1, m.end()
+    while depth:
+        depth += {"{": 1, "}": -1}.get(text[i], 0)
+        i += 1
+    return text[m.end():i - 1]
+
+
+def numbers(body):
+    return [int(n, 0) for n in re.findall(r"-?0x[0-9A-Fa-f]+|-?\d+", body)]
+
+
+def read_font(path):
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", open(path, encoding="utf-8").read(), flags=re.S)
+    bitmap = numbers(array_body(text, "Bitmaps"))
+    flat = numbers(array_body(text, "Glyphs"))
+    glyphs = [tuple(flat[k:k + 6]) for k in range(0, len(flat), 6)]
+    ranges_body = array_body(text, "Ranges")
+    ranges = [tuple(numbers(r)) for r in re.findall(r"\{([^{}]*)\}", ranges_body)] if ranges_body else []
+
+    m = re.search(r"GFXfont\s+\w+\s*(?:PROGMEM\s*)?(?:=\s*\{|\()(.*?)[})]\s*;", text, re.S)
+    # Skip the two pointer casts; then first, last, yAdvance
+    fields = [f.strip() for f in m.group(1).split(",")]
+    first, last, y_advance = (int(f, 0) for f in fields[2:5])
+
+    cmap = {}
+    if ranges:
+        for start, end, base in ranges:
+            for cp in range(start, end + 1):
+                cmap[cp] = base + cp - start
+    else:
+        for cp in range(first, last + 1):
+            cmap[cp] = cp - first
+    return bitmap, glyphs, cmap, y_advance
+
+
+# ------------------------------------------------------------
+# Subsetting
+# ------------------------------------------------------------
+def subset(font, wanted):
+    bitmap, glyphs, cmap, y_advance = font
+    cps = sorted(cp for cp in wanted if cp in cmap)
+    if not cps:
+        raise ValueError("no wanted codepoint is in the font")
+
+    # Group into runs, bridging short gaps with empty glyphs
+    runs = [[cps[0], cps[0]]]
+    for cp in cps[1:]:
+        if cp - runs[-1][1] <= RANGE_GAP + 1:
+            runs[-1][1] = cp
+        else:
+            runs.append([cp, cp])
+
+    out_bitmap, out_glyphs, out_ranges = [], [], []
+    for start, end in runs:
+        out_ranges.append((start, end, len(out_glyphs)))
+        for cp in range(start, end + 1):
+            if cp not in wanted or cp not in cmap:
+                out_glyphs.append((len(out_bitmap), 0, 0, 0, 0, 0))
+                continue
+            off, w, h, xa, xo, yo = glyphs[cmap[cp]]
+            size = (w * h + 7) // 8
+            out_glyphs.append((len(out_bitmap), w, h, xa, xo, yo))
+            out_bitmap += bitmap[off:off + size]
+    return out_bitmap, out_glyphs, out_ranges, y_advance
+
+
+def full_size(font):
+    bitmap, glyphs, _, _ = font
+    return len(bitmap) + len(glyphs) * 8
+
+
+# ------------------------------------------------------------
+def wrap(items, per_line):
+    lines = [", ".join(items[k:k + per_line]) for k in range(0, len(items), per_line)]
+    return "    " + ",\n    ".join(lines) + "};\n"
+
+
+def build():
+    ui = ui_codepoints()
+    built, missing = [], []
+    for source, symbol, macro, use_ui, extra in FONTS:
+        path = find_source(source)
+        if not path:
+            missing.append((source, symbol, macro))
+            continue
+        wanted = set(ord(ch) for ch in extra) | (ui if use_ui else set())
+        font = read_font(path)
+        built.append((source, symbol, macro, full_size(font), subset(font, wanted)))
+
+    with open(OUT_H, "w", newline="\n") as o:
+        o.write("#pragma once\n// Generated by build_fonts.py — do not edit\n")
+        o.write("#include <LovyanGFX.hpp>\n\n")
+        for source, symbol, macro, *_ in built:
+            o.write("extern const lgfx::GFXfont %s; // subset of %s\n" % (symbol, source))
+            o.write("#define %s (&%s)\n" % (macro, symbol))
+        for source, symbol, macro in missing:
+            o.write("// %s: source not found, not subset\n" % source)
+            if source.startswith("Free"):
+                o.write("#define %s (&fonts::%s)\n" % (macro, source))
+        o.write(("\n// sources: %s" % " ".join(s for s, *_ in built)).rstrip() + "\n")
+
+    with open(OUT_CPP, "w", newline="\n") as o:
+        o.write("// Generated by build_fonts.py — do not edit\n")
+        o.write('#include "font_data.h"\n')
+        for source, symbol, macro, full, (bitmap, glyphs, ranges, y_adv) in built:
+            size = len(bitmap) + len(glyphs) * 8 + len(ranges) * 6
+            o.write("\n// %s: %d glyphs in %d range(s), %d B (full font %d B)\n"
+                    % (source, len(glyphs), len(ranges), size, full))
+            o.write("static const uint8_t %sBitmaps[] = {\n" % symbol)
+            o.write(wrap(["0x%02X" % b for b in bitmap] or ["0"], 12))
+            o.write("static const lgfx::GFXglyph %sGlyphs[] = {\n" % symbol)
+            o.write(wrap(["{%d, %d, %d, %d, %d, %d}" % g for g in glyphs], 3))
+            first, last = ranges[0][0], ranges[-1][1]
+            if len(ranges) == 1:
+                # One run: glyphs are indexed directly by codepoint - first
+                o.write("const lgfx::GFXfont %s((uint8_t *)%sBitmaps,\n"
+                        "                          (lgfx::GFXglyph *)%sGlyphs, 0x%X, 0x%X, %d);\n"
+                        % (symbol, symbol, symbol, first, last, y_adv))
+                continue
+            o.write("static const lgfx::EncodeRange %sRanges[] = {\n" % symbol)
+            o.write(wrap(["{0x%X, 0x%X, %d}" % r for r in ranges], 3))
+            o.write("const lgfx::GFXfont %s((uint8_t *)%sBitmaps,\n"
+                    "                          (lgfx::GFXglyph *)%sGlyphs, 0x%X, 0x%X, %d,\n"
+                    "                          (lgfx::EncodeRange *)%sRanges, %d);\n"
+                    % (symbol, symbol, symbol, first, last, y_adv, symbol, len(ranges)))
+
+    for source, symbol, _, full, (bitmap, glyphs, ranges, _) in built:
+        size = len(bitmap) + len(glyphs) * 8 + len(ranges) * 6
+        print("[fonts] %s -> %s: %d glyphs, %d B (was %d B)"
+              % (source, symbol, len(glyphs), size, full))
+    for source, *_ in missing:
+        print("[fonts] %s: source not found, not subset" % source)
+
+
+def stale():
+    if not os.path.exists(OUT_CPP) or not os.path.exists(OUT_H):
+        return True
+    built = min(os.path.getmtime(OUT_CPP), os.path.getmtime(OUT_H))
+    header = open(OUT_H, encoding="utf-8").read()
+    for source, *_ in FONTS:
+        path = find_source(source)
+        # A source that appeared (libdeps installed, Thai fonts added)
+        if path and ("// sources:" not in header or source not in header.split("// sources:")[1]):
+            return True
+        if path and os.path.getmtime(path) > built:
+            return True
+    inputs = UI_SOURCES + ["build_fonts.py"]
+    return any(os.path.getmtime(os.path.join(ROOT, s)) > built for s in inputs)
+
+
+try:
+    Import("env")  # PlatformIO pre-build hook
+    if stale():
+        build()
+except NameError:
+    if __name__ == "__main__":
+        build()
+        sys.exit(0)
@@ -14,6 +14,7 @@
 #define PCF8574_ADDR 0x20 // IR sensor expander
 #define FT6236_ADDR 0x38  // Capacitive touch controller
 // DS3231 RTC uses default 0x68 (handled by RTClib)
+#define RTC_SQW_PIN -1 // DS3231 SQW (1 Hz) if wired; -1: edges are polled
 
 // --- SPI LCD (ST7796S 4.0" 480x320) ---
 #define LCD_MOSI_PIN 32
@@ -37,6 +38,10 @@
 // --- Display (Landscape Mode) ---
 #define LCD_WIDTH 480
 #define LCD_HEIGHT 320
+#define DISPLAY_STRIP_LINES 16 // rows per internal-SRAM DMA strip (x2)
+// UI canvas format: 16 = RGB565, 8 / 4 = palette-indexed (COL_* become
+// palette indices, expanded to RGB565 while the strips are filled)
+#define UI_CANVAS_BPP 16
 
 // --- Time Slots (7 slots) ---
 #define NUM_TIME_SLOTS 7
@@ -49,6 +54,10 @@
 // 5 = เย็น หลังอาหาร
 // 6 = ก่อนนอน
 
+#define SCHED_MAX_RULES 32 // dose calendar: the slots + own-time rules
+#define SCHED_GRACE_MIN 120 // a dose this late (stall, reboot) is still raised
+#define SCHED_CATCHUP_H 24  // on boot, look back at most this far
+
 // --- Medicine Modules (6 slots on PCA9685 ch0-5) ---
 #define NUM_MODULES 6
 #define MAX_MED_NAME 16
@@ -57,3 +66,23 @@
 #define SERVO_ANGLE_HOME 27
 #define SERVO_ANGLE_DISP 0
 #define SERVO_FREQ 50
+
+// --- Timebase (timebase.h) ---
+#define TIMEBASE_RESYNC_MS (10 * 60 * 1000UL) // re-read the DS3231
+#define TIMEBASE_EDGE_LEAD_MS 15 // start a burst this long before the edge
+#define TIMEBASE_BURST_MS 30     // longest the loop is held by one burst
+#define TIMEBASE_EDGE_FINE_US 2000 // a bracket this tight anchors finely
+#define TIMEBASE_SEEK_US 10000   // loop pacing while seeking an edge
+#define TIMEBASE_HUNT_MAX_MS 5000 // give up, retry at the next resync...
+#define TIMEBASE_RETRY_MS 3000   // ...or this soon while the anchor is coarse
+
+// --- Idle governor (power.h) ---
+#define POWER_IDLE_MS (60 * 1000UL)      // no touch: minute clock, light sleep
+#define POWER_SLEEP_MS (5 * 60 * 1000UL) // no touch: panel sleep-in
+#define POWER_ACTIVE_DELAY_MS 10         // loop() pacing while active
+#define POWER_LIGHT_SLEEP 1 // 0: idle loop paced by delay() instead
+#define POWER_IDLE_DELAY_MS 100
+#define POWER_MINUTE_MARGIN_US 20000 // wake this long after the minute turns
+
+// --- UI Glyph Cache ---
+#define GLYPH_CACHE_BYTES (192 * 1024) // PSRAM budget for rendered glyphs
@@ -0,0 +1,127 @@
+#include "anim.h"
+
+// ============================================================
+// Tween slots
+// ============================================================
+struct Tween {
+  bool active;
+  unsigned long startMs;
+  Keyframe frames[MAX_KEYFRAMES];
+  uint8_t count;
+  Easing ease;
+  TweenUpdate onUpdate;
+  TweenDone onDone;
+  int arg;
+};
+
+static Tween tweens[MAX_TWEENS];
+static unsigned long lastFrameMs = 0;
+
+static float applyEasing(Easing ease, float t) {
+  switch (ease) {
+  case EASE_IN_QUAD:
+    return t * t;
+  case EASE_OUT_QUAD:
+    return t * (2 - t);
+  case EASE_IN_OUT_QUAD:
+    return t < 0.5f ? 2 * t * t : -1 + (4 - 2 * t) * t;
+  case EASE_OUT_BACK: {
+    const float c1 = 1.70158f, c3 = c1 + 1;
+    float u = t - 1;
+    return 1 + c3 * u * u * u + c1 * u * u;
+  }
+  default:
+    return t;
+  }
+}
+
+// Value at elapsed time; the easing applies within each keyframe segment
+static float sample(const Tween &tw, unsigned long elapsed) {
+  const Keyframe *f = tw.frames;
+  if (elapsed <= f[0].atMs)
+    return f[0].value;
+  for (int i = 1; i < tw.count; i++) {
+    if (elapsed <= f[i].atMs) {
+      float span = f[i].atMs - f[i - 1].atMs;
+      float t = span > 0 ? (elapsed - f[i - 1].atMs) / span : 1.0f;
+      return f[i - 1].value +
+             (f[i].value - f[i - 1].value) * applyEasing(tw.ease, t);
+    }
+  }
+  return f[tw.count - 1].value;
+}
+
+// ============================================================
+int animStart(const Keyframe *frames, int count, Easing ease,
+              TweenUpdate onUpdate, TweenDone onDone, int arg) {
+  if (count < 1 || count > MAX_KEYFRAMES)
+    return -1;
+  for (int i = 0; i < MAX_TWEENS; i++) {
+    Tween &tw = tweens[i];
+    if (tw.active)
+      continue;
+    tw.active = true;
+    tw.startMs = millis();
+    memcpy(tw.frames, frames, count * sizeof(Keyframe));
+    tw.count = count;
+    tw.ease = ease;
+    tw.onUpdate = onUpdate;
+    tw.onDone = onDone;
+    tw.arg = arg;
+    if (onUpdate)
+      onUpdate(frames[0].value, arg);
+    return i;
+  }
+  Serial.println("[Anim] No free tween slot");
+  return -1;
+}
+
+int animTween(float from, float to, uint16_t durationMs, Easing ease,
+              TweenUpdate onUpdate, TweenDone onDone, int arg) {
+  Keyframe kf[2] = {{0, from}, {durationMs, to}};
+  return animStart(kf, 2, ease, onUpdate, onDone, arg);
+}
+
+void animCancel(int id) {
+  if (id >= 0 && id < MAX_TWEENS)
+    tweens[id].active = false;
+}
+
+void animCancelAll(void) {
+  for (int i = 0; i < MAX_TWEENS; i++)
+    tweens[i].active = false;
+}
+
+bool animActive(void) {
+  for (int i = 0; i < MAX_TWEENS; i++) {
+    if (tweens[i].active)
+      return true;
+  }
+  return false;
+}
+
+// ============================================================
+// Step every active tween once per frame. Completion callbacks run after
+// the final value has been applied and the slot is free, so they can
+// chain new tweens.
+// ============================================================
+void animLoop(void) {
+  unsigned long now = millis();
+  if (now - lastFrameMs < ANIM_FRAME_MS)
+    return;
+  lastFrameMs = now;
+
+  for (int i = 0; i < MAX_TWEENS; i++) {
+    Tween &tw = tweens[i];
+    if (!tw.active)
+      continue;
+    unsigned long elapsed = now - tw.startMs;
+    if (tw.onUpdate)
+      tw.onUpdate(sample(tw, elapsed), tw.arg);
+    if (tw.active && elapsed >= tw.frames[tw.count - 1].atMs) {
+      tw.active = false;
+      if (tw.onDone)
+        tw.onDone(tw.arg);
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <Arduino.h>
+
+// ============================================================
+// Frame-timed tween engine — replaces blocking delay() animations.
+// Tweens interpolate between keyframes with an easing curve and are
+// stepped from uiLoop() at most once per ANIM_FRAME_MS.
+// ============================================================
+#define MAX_TWEENS 6
+#define MAX_KEYFRAMES 6
+#define ANIM_FRAME_MS 20
+
+enum Easing {
+  EASE_LINEAR,
+  EASE_IN_QUAD,
+  EASE_OUT_QUAD,
+  EASE_IN_OUT_QUAD,
+  EASE_OUT_BACK // overshoots ~10% then settles (badge "pop")
+};
+
+struct Keyframe {
+  uint16_t atMs; // offset from tween start
+  float value;
+};
+
+typedef void (*TweenUpdate)(float value, int arg);
+typedef void (*TweenDone)(int arg);
+
+// Returns a tween id, or -1 when all slots are busy
+int animStart(const Keyframe *frames, int count, Easing ease,
+              TweenUpdate onUpdate, TweenDone onDone = nullptr, int arg = 0);
+int animTween(float from, float to, uint16_t durationMs, Easing ease,
+              TweenUpdate onUpdate, TweenDone onDone = nullptr, int arg = 0);
+void animCancel(int id);
+void animCancelAll(void);
+bool animActive(void);
+void animLoop(void);
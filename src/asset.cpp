@@ -0,0 +1,109 @@
+#include "asset.h"
+#include "asset_data.h"
+#include "console.h"
+#include "pixel_kernels.h"
+#include "profiler.h"
+
+// ============================================================
+// Streaming decoder
+// ============================================================
+void assetDraw(LGFX_Sprite &dst, const Asset &a, int x, int y) {
+  uint16_t *buf = (uint16_t *)dst.getBuffer();
+  if (!buf || dst.getColorDepth() != 16)
+    return;
+  int32_t cx, cy, cw, ch;
+  dst.getClipRect(&cx, &cy, &cw, &ch);
+  int x0 = cx > 0 ? cx : 0;
+  int y0 = cy > 0 ? cy : 0;
+  int x1 = cx + cw < dst.width() ? cx + cw : dst.width();
+  int y1 = cy + ch < dst.height() ? cy + ch : dst.height();
+  int stride = dst.width();
+
+  const uint8_t *p = a.data;
+  const uint8_t *end = a.data + a.size;
+  int col = 0, row = 0;
+  while (p < end && row < a.h) {
+    uint8_t op = *p++;
+    int run, index;
+    if (!(op & 0x80)) {
+      run = (op >> 4) + 1;
+      index = op & 0x0F;
+    } else if (!(op & 0x40)) {
+      run = (op & 0x3F) + 1;
+      index = *p++;
+    } else {
+      run = ((op & 0x3F) << 8 | p[0]) + 1;
+      index = p[1];
+      p += 2;
+    }
+
+    // Emit the run as one span per row it covers
+    while (run > 0 && row < a.h) {
+      int n = a.w - col < run ? a.w - col : run;
+      int py = y + row;
+      if (index != 0 && index < a.paletteCount && py >= y0 && py < y1) {
+        int sx = x + col, sn = n;
+        if (sx < x0) {
+          sn -= x0 - sx;
+          sx = x0;
+        }
+        if (sx + sn > x1)
+          sn = x1 - sx;
+        if (sn > 0)
+          pixFill(buf + py * stride + sx, a.palette[index], sn);
+      }
+      run -= n;
+      col += n;
+      if (col == a.w) {
+        col = 0;
+        row++;
+      }
+    }
+  }
+}
+
+// ============================================================
+// `assets` — decode throughput and flash footprint of every icon
+// ============================================================
+static void assetsCommand(const char *) {
+  int maxW = 0, maxH = 0;
+  for (int i = 0; i < ASSET_COUNT; i++) {
+    maxW = assetTable[i]->w > maxW ? assetTable[i]->w : maxW;
+    maxH = assetTable[i]->h > maxH ? assetTable[i]->h : maxH;
+  }
+  LGFX_Sprite scratch;
+  scratch.setColorDepth(16);
+  if (!scratch.createSprite(maxW, maxH)) {
+    Serial.println("[Assets] Out of memory");
+    return;
+  }
+
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  uint32_t rawTotal = 0, packedTotal = 0;
+  Serial.printf("[Assets] %d icons\n", ASSET_COUNT);
+  for (int i = 0; i < ASSET_COUNT; i++) {
+    const Asset &a = *assetTable[i];
+    uint32_t raw = (uint32_t)a.w * a.h * 2;
+    uint32_t packed = a.size + a.paletteCount * 2;
+    rawTotal += raw;
+    packedTotal += packed;
+
+    const int reps = 500;
+    uint32_t t = profStamp();
+    for (int r = 0; r < reps; r++)
+      assetDraw(scratch, a, 0, 0);
+    uint32_t us = (profStamp() - t) / mhz;
+    Serial.printf("  %-14s %2dx%-2d %5u B -> %4u B  %6.1f MB/s\n",
+                  assetNames[i], a.w, a.h, (unsigned)raw, (unsigned)packed,
+                  us ? (float)raw * reps / us : 0.0f);
+  }
+  Serial.printf("  total %u B as RGB565, %u B packed (%u B saved)\n",
+                (unsigned)rawTotal, (unsigned)packedTotal,
+                (unsigned)(rawTotal - packedTotal));
+  scratch.deleteSprite();
+}
+
+void assetSetup(void) {
+  consoleRegister("assets", assetsCommand,
+                  "icon decode MB/s and flash saved vs RGB565");
+}
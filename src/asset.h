@@ -0,0 +1,29 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// Compressed image assets (icons)
+// build_assets.py converts assets/icons/*.png into palette + RLE
+// streams (src/asset_data.cpp). Palette index 0 is transparent; the
+// rest are RGB565, most frequent first. Ops, one per run:
+//   0RRRIIII              run of R+1 (1..8) of index I (0..15)
+//   10RRRRRR  I           run of R+1 (1..64) of index I
+//   11RRRRRR  RRRRRRRR  I run of R+1 (1..16384) of index I
+// Runs wrap across rows. The decoder streams runs straight into the
+// target's pixel buffer as spans — no full-image intermediate.
+// ============================================================
+struct Asset {
+  uint16_t w, h;
+  uint16_t paletteCount;   // including the transparent slot 0
+  const uint16_t *palette; // RGB565
+  const uint8_t *data;     // op stream
+  uint32_t size;           // bytes of data
+};
+
+// Draws at (x, y), clipped to the sprite's clip rect. 16-bit targets
+// only: on a palette-indexed sprite the call is skipped.
+void assetDraw(LGFX_Sprite &dst, const Asset &a, int x, int y);
+
+void assetSetup(void); // registers the `assets` console command
@@ -0,0 +1,130 @@
+// Generated by build_assets.py from assets/icons — do not edit
+#include "asset_data.h"
+
+// 24x24, 3 colours, 110 B (raw 1152 B)
+static const uint16_t pill_capsule_pal[] = {
+    0x0000, 0x2652, 0xFFDF, 0x4A8A};
+static const uint8_t pill_capsule_data[] = {
+    0xC0, 0x4C, 0x00, 0x43, 0x91, 0x00, 0x03, 0x41, 0x03, 0x8F, 0x00, 0x03,
+    0x61, 0x03, 0x8E, 0x00, 0x03, 0x71, 0x03, 0x8D, 0x00, 0x03, 0x88, 0x01,
+    0x03, 0x8C, 0x00, 0x03, 0x89, 0x01, 0x03, 0x8B, 0x00, 0x03, 0x89, 0x01,
+    0x13, 0x8B, 0x00, 0x03, 0x71, 0x03, 0x12, 0x03, 0x8B, 0x00, 0x03, 0x51,
+    0x03, 0x32, 0x03, 0x8B, 0x00, 0x03, 0x31, 0x03, 0x52, 0x03, 0x8B, 0x00,
+    0x03, 0x11, 0x03, 0x72, 0x03, 0x8B, 0x00, 0x13, 0x89, 0x02, 0x03, 0x8B,
+    0x00, 0x03, 0x89, 0x02, 0x03, 0x8C, 0x00, 0x03, 0x88, 0x02, 0x03, 0x8D,
+    0x00, 0x03, 0x72, 0x03, 0x8E, 0x00, 0x03, 0x62, 0x03, 0x8F, 0x00, 0x03,
+    0x42, 0x03, 0x91, 0x00, 0x43, 0xC0, 0x4C, 0x00};
+const Asset ICON_PILL_CAPSULE = {
+    24, 24, 4, pill_capsule_pal, pill_capsule_data, sizeof(pill_capsule_data)};
+
+// 24x24, 2 colours, 69 B (raw 1152 B)
+static const uint16_t pill_generic_pal[] = {
+    0x0000, 0x979A, 0x15D0};
+static const uint8_t pill_generic_data[] = {
+    0xC0, 0x95, 0x00, 0x22, 0x51, 0x22, 0x89, 0x00, 0x12, 0x8B, 0x01, 0x12,
+    0x60, 0x12, 0x8D, 0x01, 0x12, 0x40, 0x12, 0x8F, 0x01, 0x12, 0x30, 0x02,
+    0x91, 0x01, 0x02, 0x30, 0x02, 0x91, 0x01, 0x02, 0x30, 0x02, 0x91, 0x01,
+    0x02, 0x30, 0x02, 0x91, 0x01, 0x02, 0x30, 0x12, 0x8F, 0x01, 0x12, 0x40,
+    0x12, 0x8D, 0x01, 0x12, 0x60, 0x12, 0x8B, 0x01, 0x12, 0x89, 0x00, 0x22,
+    0x51, 0x22, 0xC0, 0x95, 0x00};
+const Asset ICON_PILL_GENERIC = {
+    24, 24, 3, pill_generic_pal, pill_generic_data, sizeof(pill_generic_data)};
+
+// 24x24, 3 colours, 94 B (raw 1152 B)
+static const uint16_t pill_syrup_pal[] = {
+    0x0000, 0x8AC5, 0xFFDF, 0x4A8A};
+static const uint8_t pill_syrup_data[] = {
+    0xB8, 0x00, 0x53, 0x91, 0x00, 0x53, 0x91, 0x00, 0x53, 0x91, 0x00, 0x53,
+    0x92, 0x00, 0x31, 0x93, 0x00, 0x31, 0x8E, 0x00, 0x8D, 0x01, 0x89, 0x00,
+    0x8D, 0x01, 0x89, 0x00, 0x8D, 0x01, 0x89, 0x00, 0x8D, 0x01, 0x89, 0x00,
+    0x11, 0x89, 0x02, 0x11, 0x89, 0x00, 0x11, 0x89, 0x02, 0x11, 0x89, 0x00,
+    0x11, 0x89, 0x02, 0x11, 0x89, 0x00, 0x11, 0x89, 0x02, 0x11, 0x89, 0x00,
+    0x11, 0x89, 0x02, 0x11, 0x89, 0x00, 0x11, 0x89, 0x02, 0x11, 0x89, 0x00,
+    0x8D, 0x01, 0x89, 0x00, 0x8D, 0x01, 0x89, 0x00, 0x8D, 0x01, 0x89, 0x00,
+    0x8D, 0x01, 0xB4, 0x00};
+const Asset ICON_PILL_SYRUP = {
+    24, 24, 4, pill_syrup_pal, pill_syrup_data, sizeof(pill_syrup_data)};
+
+// 24x24, 3 colours, 121 B (raw 1152 B)
+static const uint16_t pill_tablet_pal[] = {
+    0x0000, 0xFFDF, 0x8472, 0xADB7};
+static const uint8_t pill_tablet_data[] = {
+    0xB7, 0x00, 0x72, 0x8D, 0x00, 0x12, 0x71, 0x12, 0x8A, 0x00, 0x12, 0x89,
+    0x01, 0x12, 0x88, 0x00, 0x02, 0x51, 0x13, 0x51, 0x02, 0x60, 0x12, 0x51,
+    0x13, 0x51, 0x12, 0x50, 0x02, 0x61, 0x13, 0x61, 0x02, 0x40, 0x02, 0x71,
+    0x13, 0x71, 0x02, 0x30, 0x02, 0x71, 0x13, 0x71, 0x02, 0x30, 0x02, 0x71,
+    0x13, 0x71, 0x02, 0x30, 0x02, 0x71, 0x13, 0x71, 0x02, 0x30, 0x02, 0x71,
+    0x13, 0x71, 0x02, 0x30, 0x02, 0x71, 0x13, 0x71, 0x02, 0x30, 0x02, 0x71,
+    0x13, 0x71, 0x02, 0x30, 0x02, 0x71, 0x13, 0x71, 0x02, 0x40, 0x02, 0x61,
+    0x13, 0x61, 0x02, 0x50, 0x12, 0x51, 0x13, 0x51, 0x12, 0x60, 0x02, 0x51,
+    0x13, 0x51, 0x02, 0x88, 0x00, 0x12, 0x89, 0x01, 0x12, 0x8A, 0x00, 0x12,
+    0x71, 0x12, 0x8D, 0x00, 0x72, 0xB7, 0x00};
+const Asset ICON_PILL_TABLET = {
+    24, 24, 4, pill_tablet_pal, pill_tablet_data, sizeof(pill_tablet_data)};
+
+// 24x24, 3 colours, 115 B (raw 1152 B)
+static const uint16_t pill_vitamin_pal[] = {
+    0x0000, 0xFBE2, 0xEAC1, 0xFED5};
+static const uint8_t pill_vitamin_data[] = {
+    0xB7, 0x00, 0x72, 0x8D, 0x00, 0x12, 0x71, 0x12, 0x8A, 0x00, 0x12, 0x89,
+    0x01, 0x12, 0x88, 0x00, 0x02, 0x8D, 0x01, 0x02, 0x60, 0x12, 0x8D, 0x01,
+    0x12, 0x50, 0x02, 0x21, 0x33, 0x88, 0x01, 0x02, 0x40, 0x02, 0x31, 0x33,
+    0x89, 0x01, 0x02, 0x30, 0x02, 0x31, 0x33, 0x89, 0x01, 0x02, 0x30, 0x02,
+    0x31, 0x33, 0x89, 0x01, 0x02, 0x30, 0x02, 0x91, 0x01, 0x02, 0x30, 0x02,
+    0x91, 0x01, 0x02, 0x30, 0x02, 0x91, 0x01, 0x02, 0x30, 0x02, 0x91, 0x01,
+    0x02, 0x30, 0x02, 0x91, 0x01, 0x02, 0x40, 0x02, 0x8F, 0x01, 0x02, 0x50,
+    0x12, 0x8D, 0x01, 0x12, 0x60, 0x02, 0x8D, 0x01, 0x02, 0x88, 0x00, 0x12,
+    0x89, 0x01, 0x12, 0x8A, 0x00, 0x12, 0x71, 0x12, 0x8D, 0x00, 0x72, 0xB7,
+    0x00};
+const Asset ICON_PILL_VITAMIN = {
+    24, 24, 4, pill_vitamin_pal, pill_vitamin_data, sizeof(pill_vitamin_data)};
+
+// 32x32, 1 colours, 112 B (raw 2048 B)
+static const uint16_t status_fail_pal[] = {
+    0x0000, 0xFFFF};
+static const uint8_t status_fail_data[] = {
+    0xC0, 0xA6, 0x00, 0x11, 0x8D, 0x00, 0x11, 0x8C, 0x00, 0x31, 0x8B, 0x00,
+    0x31, 0x8A, 0x00, 0x51, 0x89, 0x00, 0x51, 0x89, 0x00, 0x61, 0x70, 0x61,
+    0x8A, 0x00, 0x61, 0x50, 0x61, 0x8C, 0x00, 0x61, 0x30, 0x61, 0x8E, 0x00,
+    0x61, 0x10, 0x61, 0x90, 0x00, 0x8D, 0x01, 0x92, 0x00, 0x8B, 0x01, 0x94,
+    0x00, 0x89, 0x01, 0x96, 0x00, 0x71, 0x97, 0x00, 0x71, 0x96, 0x00, 0x89,
+    0x01, 0x94, 0x00, 0x8B, 0x01, 0x92, 0x00, 0x8D, 0x01, 0x90, 0x00, 0x61,
+    0x10, 0x61, 0x8E, 0x00, 0x61, 0x30, 0x61, 0x8C, 0x00, 0x61, 0x50, 0x61,
+    0x8A, 0x00, 0x61, 0x70, 0x61, 0x89, 0x00, 0x51, 0x89, 0x00, 0x51, 0x8A,
+    0x00, 0x31, 0x8B, 0x00, 0x31, 0x8C, 0x00, 0x11, 0x8D, 0x00, 0x11, 0xC0,
+    0xA6, 0x00};
+const Asset ICON_STATUS_FAIL = {
+    32, 32, 2, status_fail_pal, status_fail_data, sizeof(status_fail_data)};
+
+// 32x32, 1 colours, 86 B (raw 2048 B)
+static const uint16_t status_ok_pal[] = {
+    0x0000, 0xFFFF};
+static const uint8_t status_ok_data[] = {
+    0xC0, 0xD8, 0x00, 0x11, 0x9C, 0x00, 0x31, 0x9A, 0x00, 0x51, 0x98, 0x00,
+    0x61, 0x97, 0x00, 0x61, 0x97, 0x00, 0x61, 0x98, 0x00, 0x51, 0x98, 0x00,
+    0x61, 0x8A, 0x00, 0x11, 0x8A, 0x00, 0x61, 0x8A, 0x00, 0x31, 0x88, 0x00,
+    0x61, 0x8A, 0x00, 0x51, 0x60, 0x61, 0x8B, 0x00, 0x61, 0x40, 0x61, 0x8D,
+    0x00, 0x61, 0x20, 0x61, 0x8F, 0x00, 0x61, 0x00, 0x61, 0x91, 0x00, 0x8C,
+    0x01, 0x93, 0x00, 0x8B, 0x01, 0x94, 0x00, 0x89, 0x01, 0x96, 0x00, 0x71,
+    0x98, 0x00, 0x51, 0x9A, 0x00, 0x31, 0x9C, 0x00, 0x11, 0xC0, 0xB1, 0x00};
+const Asset ICON_STATUS_OK = {
+    32, 32, 2, status_ok_pal, status_ok_data, sizeof(status_ok_data)};
+
+const Asset *const assetTable[ASSET_COUNT] = {
+    &ICON_PILL_CAPSULE,
+    &ICON_PILL_GENERIC,
+    &ICON_PILL_SYRUP,
+    &ICON_PILL_TABLET,
+    &ICON_PILL_VITAMIN,
+    &ICON_STATUS_FAIL,
+    &ICON_STATUS_OK,
+};
+const char *const assetNames[ASSET_COUNT] = {
+    "pill_capsule",
+    "pill_generic",
+    "pill_syrup",
+    "pill_tablet",
+    "pill_vitamin",
+    "status_fail",
+    "status_ok",
+};
@@ -0,0 +1,15 @@
+#pragma once
+// Generated by build_assets.py from assets/icons — do not edit
+#include "asset.h"
+
+extern const Asset ICON_PILL_CAPSULE;
+extern const Asset ICON_PILL_GENERIC;
+extern const Asset ICON_PILL_SYRUP;
+extern const Asset ICON_PILL_TABLET;
+extern const Asset ICON_PILL_VITAMIN;
+extern const Asset ICON_STATUS_FAIL;
+extern const Asset ICON_STATUS_OK;
+
+#define ASSET_COUNT 7
+extern const Asset *const assetTable[ASSET_COUNT];
+extern const char *const assetNames[ASSET_COUNT];
@@ -0,0 +1,64 @@
+#include "console.h"
+
+// ============================================================
+// Command table
+// ============================================================
+struct ConsoleCmd {
+  const char *name;
+  const char *help;
+  ConsoleHandler fn;
+};
+
+static ConsoleCmd cmds[CONSOLE_MAX_CMDS];
+static int numCmds = 0;
+static char line[CONSOLE_LINE_MAX];
+static int lineLen = 0;
+
+void consoleRegister(const char *name, ConsoleHandler fn, const char *help) {
+  if (numCmds >= CONSOLE_MAX_CMDS) {
+    Serial.printf("[Console] Table full, '%s' dropped\n", name);
+    return;
+  }
+  cmds[numCmds++] = {name, help, fn};
+}
+
+static void execute(char *cmd) {
+  while (*cmd == ' ')
+    cmd++;
+  if (!*cmd)
+    return;
+  char *args = cmd;
+  while (*args && *args != ' ')
+    args++;
+  if (*args)
+    *args++ = '\0';
+  while (*args == ' ')
+    args++;
+
+  if (strcmp(cmd, "help") == 0) {
+    for (int i = 0; i < numCmds; i++)
+      Serial.printf("  %-10s %s\n", cmds[i].name, cmds[i].help);
+    return;
+  }
+  for (int i = 0; i < numCmds; i++) {
+    if (strcmp(cmd, cmds[i].name) == 0) {
+      cmds[i].fn(args);
+      return;
+    }
+  }
+  Serial.printf("[Console] Unknown command '%s' (try 'help')\n", cmd);
+}
+
+// ============================================================
+void consoleLoop(void) {
+  while (Serial.available() > 0) {
+    int c = Serial.read();
+    if (c == '\r' || c == '\n') {
+      line[lineLen] = '\0';
+      lineLen = 0;
+      execute(line);
+    } else if (lineLen < CONSOLE_LINE_MAX - 1) {
+      line[lineLen++] = (char)c;
+    }
+  }
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <Arduino.h>
+
+// ============================================================
+// Serial console — line-based debug commands ("help" lists them)
+// ============================================================
+#define CONSOLE_MAX_CMDS 12
+#define CONSOLE_LINE_MAX 96 // `rx <module> <regimen>`
+
+// `args` is the rest of the line after the command name ("" if none)
+typedef void (*ConsoleHandler)(const char *args);
+
+void consoleRegister(const char *name, ConsoleHandler fn, const char *help);
+void consoleLoop(void); // non-blocking: drains whatever Serial has
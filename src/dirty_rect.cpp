@@ -0,0 +1,115 @@
+#include "dirty_rect.h"
+#include "ui_strings.h"
+
+// ============================================================
+// Damage list
+// ============================================================
+static DirtyRect rects[DIRTY_MAX_RECTS];
+static int rectCount = 0;
+
+static int32_t area(const DirtyRect &r) { return (int32_t)r.w * r.h; }
+
+// Touching rectangles count as overlapping so adjacent strips coalesce
+static bool touches(const DirtyRect &a, const DirtyRect &b) {
+  return a.x <= b.x + b.w && b.x <= a.x + a.w && a.y <= b.y + b.h &&
+         b.y <= a.y + a.h;
+}
+
+static DirtyRect unite(const DirtyRect &a, const DirtyRect &b) {
+  int x0 = a.x < b.x ? a.x : b.x;
+  int y0 = a.y < b.y ? a.y : b.y;
+  int x1 = a.x + a.w > b.x + b.w ? a.x + a.w : b.x + b.w;
+  int y1 = a.y + a.h > b.y + b.h ? a.y + a.h : b.y + b.h;
+  return {(int16_t)x0, (int16_t)y0, (int16_t)(x1 - x0), (int16_t)(y1 - y0)};
+}
+
+// ============================================================
+void dirtyAdd(int x, int y, int w, int h) {
+  // Clip to the panel
+  if (x < 0) {
+    w += x;
+    x = 0;
+  }
+  if (y < 0) {
+    h += y;
+    y = 0;
+  }
+  if (x + w > LCD_WIDTH)
+    w = LCD_WIDTH - x;
+  if (y + h > LCD_HEIGHT)
+    h = LCD_HEIGHT - y;
+  if (w <= 0 || h <= 0)
+    return;
+
+  DirtyRect r = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h};
+
+  // Absorb every rect the new one touches (repeat: the union may grow)
+  for (int i = 0; i < rectCount;) {
+    if (touches(r, rects[i])) {
+      r = unite(r, rects[i]);
+      rects[i] = rects[--rectCount];
+      i = 0;
+    } else {
+      i++;
+    }
+  }
+
+  // List full — merge with the rect whose union wastes the fewest pixels
+  if (rectCount == DIRTY_MAX_RECTS) {
+    int best = 0;
+    int32_t bestWaste = INT32_MAX;
+    for (int i = 0; i < rectCount; i++) {
+      int32_t waste = area(unite(r, rects[i])) - area(r) - area(rects[i]);
+      if (waste < bestWaste) {
+        bestWaste = waste;
+        best = i;
+      }
+    }
+    r = unite(r, rects[best]);
+    rects[best] = rects[--rectCount];
+    dirtyAdd(r.x, r.y, r.w, r.h);
+    return;
+  }
+
+  rects[rectCount++] = r;
+}
+
+void dirtyAddAll(void) {
+  rects[0] = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+  rectCount = 1;
+}
+
+void dirtyClear(void) { rectCount = 0; }
+int dirtyCount(void) { return rectCount; }
+const DirtyRect &dirtyGet(int index) { return rects[index % DIRTY_MAX_RECTS]; }
+
+// ============================================================
+// Text bounds from the current datum
+// ============================================================
+DirtyRect dirtyTextBounds(lgfx::LGFXBase &gfx, const char *str, int x,
+                          int y) {
+  int w = textWidthCached(gfx, str);
+  int h = gfx.fontHeight();
+  uint8_t datum = gfx.getTextDatum();
+
+  if (datum & 1) // center
+    x -= w / 2;
+  else if (datum & 2) // right
+    x -= w;
+
+  if (datum & 16) // baseline
+    y -= h * 3 / 4;
+  else if (datum & 4) // middle
+    y -= h / 2;
+  else if (datum & 8) // bottom
+    y -= h;
+
+  // A couple of pixels of slack for glyph overhang
+  return {(int16_t)(x - 2), (int16_t)(y - 2), (int16_t)(w + 4),
+          (int16_t)(h + 4)};
+}
+
+void dirtyAddText(lgfx::LGFXBase &gfx, const char *str, int x, int y) {
+  DirtyRect r = dirtyTextBounds(gfx, str, x, y);
+  dirtyAdd(r.x, r.y, r.w, r.h);
+}
@@ -0,0 +1,203 @@
+#pragma once
+#include "config.h"
+#include "asset.h"
+#include "display_list.h"
+#include "glyph_cache.h"
+#include "soft_shape.h"
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// Dirty-rectangle damage tracking for the UI canvas
+// Draw calls record their bounding boxes; overlapping boxes are
+// merged so only the changed regions are pushed to the panel.
+// ============================================================
+#define DIRTY_MAX_RECTS 8
+
+struct DirtyRect {
+  int16_t x, y, w, h;
+};
+
+void dirtyAdd(int x, int y, int w, int h);
+void dirtyAddAll(void);
+void dirtyClear(void);
+int dirtyCount(void);
+const DirtyRect &dirtyGet(int index);
+
+// Bounding box of a string drawn at (x, y) with the current font/datum
+DirtyRect dirtyTextBounds(lgfx::LGFXBase &gfx, const char *str, int x,
+                          int y);
+void dirtyAddText(lgfx::LGFXBase &gfx, const char *str, int x, int y);
+
+// Screen render passes (see layer_cache.h). PASS_DYNAMIC draws over a
+// cached static layer, so primitives outside a dynamic section are
+// skipped; PASS_STATIC is the caller's cue to leave dynamic sections out.
+enum LayerPass : uint8_t { PASS_FULL, PASS_STATIC, PASS_DYNAMIC };
+
+// ============================================================
+// Sprite that records damage for every draw call it forwards
+// ============================================================
+class DirtySprite : public LGFX_Sprite {
+public:
+  void setLayerPass(LayerPass p) {
+    pass = p;
+    dynamicDepth = 0;
+  }
+  LayerPass layerPass() const { return pass; }
+  void dynamicBegin() { dynamicDepth++; }
+  void dynamicEnd() { dynamicDepth--; }
+
+  // Display-list capture: the calls are appended to `dl`, and only
+  // drawn when `draw` is set
+  void recordBegin(DisplayList &dl, bool draw) {
+    dlClear(dl);
+    recorder = &dl;
+    recordDraw = draw;
+  }
+  void recordEnd() { recorder = nullptr; }
+
+  template <typename T> void fillScreen(const T &color) {
+    if (skip() || captured(DL_FILL_SCREEN, 0, 0, 0, 0, 0, color))
+      return;
+    dirtyAddAll();
+    LGFX_Sprite::fillScreen(color);
+  }
+  template <typename T>
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, const T &color) {
+    if (skip() || captured(DL_FILL_RECT, x, y, w, h, 0, color))
+      return;
+    dirtyAdd(x, y, w, h);
+    LGFX_Sprite::fillRect(x, y, w, h, color);
+  }
+  template <typename T>
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, const T &color) {
+    if (skip() || captured(DL_DRAW_RECT, x, y, w, h, 0, color))
+      return;
+    dirtyAdd(x, y, w, h);
+    LGFX_Sprite::drawRect(x, y, w, h, color);
+  }
+  template <typename T>
+  void fillRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r,
+                     const T &color) {
+    if (skip() || captured(DL_FILL_ROUND_RECT, x, y, w, h, r, color))
+      return;
+    dirtyAdd(x, y, w, h);
+    LGFX_Sprite::fillRoundRect(x, y, w, h, r, color);
+  }
+  template <typename T>
+  void drawRoundRect(int32_t x, int32_t y, int32_t w, int32_t h, int32_t r,
+                     const T &color) {
+    if (skip() || captured(DL_DRAW_ROUND_RECT, x, y, w, h, r, color))
+      return;
+    dirtyAdd(x, y, w, h);
+    LGFX_Sprite::drawRoundRect(x, y, w, h, r, color);
+  }
+  template <typename T>
+  void fillCircle(int32_t x, int32_t y, int32_t r, const T &color) {
+    if (skip() || captured(DL_FILL_CIRCLE, x, y, 0, 0, r, color))
+      return;
+    dirtyAdd(x - r, y - r, r * 2 + 1, r * 2 + 1);
+    LGFX_Sprite::fillCircle(x, y, r, color);
+  }
+  template <typename T>
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, const T &color) {
+    if (skip() || captured(DL_HLINE, x, y, w, 1, 0, color))
+      return;
+    dirtyAdd(x, y, w, 1);
+    LGFX_Sprite::drawFastHLine(x, y, w, color);
+  }
+  template <typename T>
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, const T &color) {
+    if (skip() || captured(DL_VLINE, x, y, 1, h, 0, color))
+      return;
+    dirtyAdd(x, y, 1, h);
+    LGFX_Sprite::drawFastVLine(x, y, h, color);
+  }
+  // Anti-aliased shapes from the coverage masks (soft_shape.h)
+  void fillSoftRoundRect(int x, int y, int w, int h, int r, uint16_t color) {
+    if (skip() || captured(DL_SOFT_ROUND_RECT, x, y, w, h, r, color))
+      return;
+    dirtyAdd(x, y, w, h);
+    softRoundRect(*this, x, y, w, h, r, color);
+  }
+  void fillSoftShadow(int x, int y, int w, int h, int r, int blur,
+                      uint16_t color) {
+    if (skip())
+      return;
+    if (recorder) {
+      dlRecordShadow(*recorder, x, y, w, h, r, blur, color);
+      if (!recordDraw)
+        return;
+    }
+    dirtyAdd(x - blur, y - blur, w + blur * 2, h + blur * 2);
+    softShadow(*this, x, y, w, h, r, blur, color);
+  }
+  void drawAsset(const Asset &a, int x, int y) {
+    if (skip())
+      return;
+    if (recorder) {
+      dlRecordImage(*recorder, a, x, y);
+      if (!recordDraw)
+        return;
+    }
+    dirtyAdd(x, y, a.w, a.h);
+    assetDraw(*this, a, x, y);
+  }
+  // Opaque text is served from the glyph cache
+  template <typename T> void setTextColor(const T &fg) {
+    textFg = textBg = (uint16_t)fg;
+    LGFX_Sprite::setTextColor(fg);
+  }
+  template <typename T, typename U>
+  void setTextColor(const T &fg, const U &bg) {
+    textFg = (uint16_t)fg;
+    textBg = (uint16_t)bg;
+    LGFX_Sprite::setTextColor(fg, bg);
+  }
+  size_t drawString(const char *str, int32_t x, int32_t y) {
+    if (skip())
+      return 0;
+    if (recorder) {
+      dlRecordText(*recorder, *this, str, x, y, textFg, textBg);
+      if (!recordDraw)
+        return textWidth(str);
+    }
+    dirtyAddText(*this, str, x, y);
+#if UI_CANVAS_BPP == 16
+    if (textFg != textBg) {
+      int w = glyphDrawString(*this, str, x, y, textFg, textBg);
+      if (w >= 0)
+        return w;
+    }
+#endif
+    return LGFX_Sprite::drawString(str, x, y);
+  }
+
+private:
+  LayerPass pass = PASS_FULL;
+  uint16_t textFg = 0xFFFF, textBg = 0xFFFF;
+  int dynamicDepth = 0;
+  DisplayList *recorder = nullptr;
+  bool recordDraw = true;
+  bool skip() const { return pass == PASS_DYNAMIC && dynamicDepth == 0; }
+  // Records the call when capturing; true if it must not be drawn
+  bool captured(DlOp op, int x, int y, int w, int h, int r, uint16_t color) {
+    if (!recorder)
+      return false;
+    dlRecord(*recorder, op, x, y, w, h, r, color);
+    return !recordDraw;
+  }
+};
+
+// Damage-tracked overloads, so drawing code templated on the target can
+// call softRoundRect / softShadow on the canvas and on plain sprites
+inline void softRoundRect(DirtySprite &dst, int x, int y, int w, int h,
+                          int r, uint16_t color) {
+  dst.fillSoftRoundRect(x, y, w, h, r, color);
+}
+inline void softShadow(DirtySprite &dst, int x, int y, int w, int h, int r,
+                       int blur, uint16_t color) {
+  dst.fillSoftShadow(x, y, w, h, r, blur, color);
+}
+inline void assetDraw(DirtySprite &dst, const Asset &a, int x, int y) {
+  dst.drawAsset(a, x, y);
+}
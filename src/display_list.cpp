@@ -0,0 +1,330 @@
+#include "display_list.h"
+#include "asset.h"
+#include "dirty_rect.h"
+#include "glyph_cache.h"
+#include "soft_shape.h"
+
+// ============================================================
+// Recording
+// ============================================================
+void dlClear(DisplayList &dl) {
+  dl.count = 0;
+  dl.textUsed = 0;
+  dl.overflow = false;
+}
+
+static DlCmd *append(DisplayList &dl, DlOp op) {
+  if (dl.count >= DL_MAX_CMDS) {
+    dl.overflow = true;
+    return nullptr;
+  }
+  DlCmd &c = dl.cmds[dl.count++];
+  memset(&c, 0, sizeof(c)); // padding too, so commands compare by value
+  c.op = op;
+  return &c;
+}
+
+void dlRecord(DisplayList &dl, DlOp op, int x, int y, int w, int h, int r,
+              uint16_t color) {
+  DlCmd *c = append(dl, op);
+  if (!c)
+    return;
+  c->x = x;
+  c->y = y;
+  c->w = w;
+  c->h = h;
+  c->r = r;
+  c->color = color;
+  c->bx = x;
+  c->by = y;
+  c->bw = w;
+  c->bh = h;
+  if (op == DL_FILL_SCREEN) {
+    c->bx = c->by = 0;
+    c->bw = LCD_WIDTH;
+    c->bh = LCD_HEIGHT;
+  } else if (op == DL_FILL_CIRCLE) {
+    c->bx = x - r;
+    c->by = y - r;
+    c->bw = c->bh = r * 2 + 1;
+  }
+}
+
+void dlRecordShadow(DisplayList &dl, int x, int y, int w, int h, int r,
+                    int blur, uint16_t color) {
+  int n = dl.count;
+  dlRecord(dl, DL_SOFT_SHADOW, x, y, w, h, r, color);
+  if (dl.count == n)
+    return;
+  DlCmd &c = dl.cmds[dl.count - 1];
+  c.datum = blur;
+  c.bx -= blur;
+  c.by -= blur;
+  c.bw += blur * 2;
+  c.bh += blur * 2;
+}
+
+void dlRecordImage(DisplayList &dl, const Asset &image, int x, int y) {
+  int n = dl.count;
+  dlRecord(dl, DL_IMAGE, x, y, image.w, image.h, 0, 0);
+  if (dl.count == n)
+    return;
+  dl.cmds[n].image = &image;
+}
+
+void dlRecordText(DisplayList &dl, lgfx::LGFXBase &gfx, const char *str,
+                  int x, int y, uint16_t fg, uint16_t bg) {
+  size_t len = strlen(str);
+  if (dl.textUsed + len + 1 > DL_TEXT_BYTES) {
+    dl.overflow = true;
+    return;
+  }
+  DlCmd *c = append(dl, DL_TEXT);
+  if (!c)
+    return;
+  memcpy(dl.text + dl.textUsed, str, len + 1);
+  c->text = dl.textUsed;
+  c->len = len;
+  dl.textUsed += len + 1;
+  c->x = x;
+  c->y = y;
+  c->color = fg;
+  c->bg = bg;
+  c->font = gfx.getFont();
+  c->datum = gfx.getTextDatum();
+  DirtyRect b = dirtyTextBounds(gfx, str, x, y);
+  c->bx = b.x;
+  c->by = b.y;
+  c->bw = b.w;
+  c->bh = b.h;
+}
+
+// ============================================================
+// Replay
+// ============================================================
+static void replayCmd(const DisplayList &dl, const DlCmd &c,
+                      lgfx::LGFXBase &gfx, LGFX_Sprite *sprite) {
+  switch (c.op) {
+  case DL_FILL_SCREEN:
+    gfx.fillScreen(c.color);
+    break;
+  case DL_FILL_RECT:
+    gfx.fillRect(c.x, c.y, c.w, c.h, c.color);
+    break;
+  case DL_DRAW_RECT:
+    gfx.drawRect(c.x, c.y, c.w, c.h, c.color);
+    break;
+  case DL_FILL_ROUND_RECT:
+    gfx.fillRoundRect(c.x, c.y, c.w, c.h, c.r, c.color);
+    break;
+  case DL_DRAW_ROUND_RECT:
+    gfx.drawRoundRect(c.x, c.y, c.w, c.h, c.r, c.color);
+    break;
+  case DL_FILL_CIRCLE:
+    gfx.fillCircle(c.x, c.y, c.r, c.color);
+    break;
+  case DL_HLINE:
+    gfx.drawFastHLine(c.x, c.y, c.w, c.color);
+    break;
+  case DL_VLINE:
+    gfx.drawFastVLine(c.x, c.y, c.h, c.color);
+    break;
+  case DL_SOFT_ROUND_RECT:
+    if (sprite)
+      softRoundRect(*sprite, c.x, c.y, c.w, c.h, c.r, c.color);
+    else
+      gfx.fillRoundRect(c.x, c.y, c.w, c.h, c.r, c.color);
+    break;
+  case DL_SOFT_SHADOW:
+    if (sprite)
+      softShadow(*sprite, c.x, c.y, c.w, c.h, c.r, c.datum, c.color);
+    else
+      gfx.fillRoundRect(c.x, c.y, c.w, c.h, c.r, c.color);
+    break;
+  case DL_IMAGE:
+    if (sprite)
+      assetDraw(*sprite, *c.image, c.x, c.y);
+    break;
+  case DL_TEXT: {
+    const char *str = dl.text + c.text;
+    gfx.setFont(c.font);
+    gfx.setTextDatum(c.datum);
+    if (c.bg == c.color) {
+      gfx.setTextColor(c.color);
+    } else {
+      gfx.setTextColor(c.color, c.bg);
+#if UI_CANVAS_BPP == 16
+      if (sprite &&
+          glyphDrawString(*sprite, str, c.x, c.y, c.color, c.bg) >= 0)
+        break;
+#endif
+    }
+    gfx.drawString(str, c.x, c.y);
+    break;
+  }
+  }
+}
+
+static bool touches(const DlCmd &c, int x, int y, int w, int h) {
+  return c.bx < x + w && x < c.bx + c.bw && c.by < y + h && y < c.by + c.bh;
+}
+
+static void replayClip(const DisplayList &dl, lgfx::LGFXBase &gfx,
+                       LGFX_Sprite *sprite, int x, int y, int w, int h) {
+  gfx.setClipRect(x, y, w, h);
+  for (int i = 0; i < dl.count; i++) {
+    if (touches(dl.cmds[i], x, y, w, h))
+      replayCmd(dl, dl.cmds[i], gfx, sprite);
+  }
+  gfx.clearClipRect();
+}
+
+void dlReplay(const DisplayList &dl, lgfx::LGFXBase &gfx) {
+  for (int i = 0; i < dl.count; i++)
+    replayCmd(dl, dl.cmds[i], gfx, nullptr);
+}
+
+void dlReplayClip(const DisplayList &dl, lgfx::LGFXBase &gfx, int x, int y,
+                  int w, int h) {
+  replayClip(dl, gfx, nullptr, x, y, w, h);
+}
+
+// ============================================================
+// Diff
+// ============================================================
+static bool sameCmd(const DisplayList &a, const DlCmd &ca,
+                    const DisplayList &b, const DlCmd &cb) {
+  if (ca.op != cb.op || ca.x != cb.x || ca.y != cb.y || ca.w != cb.w ||
+      ca.h != cb.h || ca.r != cb.r || ca.color != cb.color ||
+      ca.datum != cb.datum)
+    return false;
+  if (ca.op == DL_IMAGE)
+    return ca.image == cb.image;
+  if (ca.op != DL_TEXT)
+    return true;
+  return ca.bg == cb.bg && ca.font == cb.font && ca.len == cb.len &&
+         memcmp(a.text + ca.text, b.text + cb.text, ca.len) == 0;
+}
+
+static int prefixWidth(lgfx::LGFXBase &metrics, const char *str, int n) {
+  char buf[64];
+  memcpy(buf, str, n);
+  buf[n] = '\0';
+  return metrics.textWidth(buf);
+}
+
+// Same-styled strings of equal length and width (clock, countdown): only
+// the run between the common prefix and suffix changed
+static bool textSpan(const DisplayList &a, const DlCmd &ca,
+                     const DisplayList &b, const DlCmd &cb,
+                     lgfx::LGFXBase &metrics, DlDamage damage) {
+  if (ca.op != DL_TEXT || cb.op != DL_TEXT || ca.len != cb.len ||
+      ca.len >= 64 || ca.font != cb.font || ca.datum != cb.datum ||
+      ca.x != cb.x || ca.y != cb.y || ca.color != cb.color ||
+      ca.bg != cb.bg || ca.bx != cb.bx || ca.bw != cb.bw)
+    return false;
+
+  const char *sa = a.text + ca.text;
+  const char *sb = b.text + cb.text;
+  int n = ca.len, p = 0, q = 0;
+  while (p < n && sa[p] == sb[p])
+    p++;
+  while (q < n - p && sa[n - 1 - q] == sb[n - 1 - q])
+    q++;
+  // Keep UTF-8 sequences whole
+  while (p > 0 && (sa[p] & 0xC0) == 0x80)
+    p--;
+  while (q > 0 && (sa[n - q] & 0xC0) == 0x80)
+    q--;
+
+  const lgfx::IFont *font = metrics.getFont();
+  metrics.setFont(ca.font);
+  int x0 = prefixWidth(metrics, sa, p);
+  int x1 = prefixWidth(metrics, sa, n - q);
+  int x1b = prefixWidth(metrics, sb, n - q);
+  metrics.setFont(font);
+  if (x1b > x1)
+    x1 = x1b;
+
+  // Bounds carry 2 px of overhang slack on each side
+  damage(ca.bx + x0, ca.by, x1 - x0 + 4, ca.bh);
+  return true;
+}
+
+void dlDiff(const DisplayList &a, const DisplayList &b,
+            lgfx::LGFXBase &metrics, DlDamage damage) {
+  if (a.overflow || b.overflow || a.count != b.count) {
+    // Different structure — damage everything either list touches
+    int x0 = LCD_WIDTH, y0 = LCD_HEIGHT, x1 = 0, y1 = 0;
+    const DisplayList *lists[2] = {&a, &b};
+    for (const DisplayList *dl : lists) {
+      for (int i = 0; i < dl->count; i++) {
+        const DlCmd &c = dl->cmds[i];
+        x0 = c.bx < x0 ? c.bx : x0;
+        y0 = c.by < y0 ? c.by : y0;
+        x1 = c.bx + c.bw > x1 ? c.bx + c.bw : x1;
+        y1 = c.by + c.bh > y1 ? c.by + c.bh : y1;
+      }
+    }
+    if (a.overflow || b.overflow) {
+      x0 = y0 = 0;
+      x1 = LCD_WIDTH;
+      y1 = LCD_HEIGHT;
+    }
+    if (x1 > x0 && y1 > y0)
+      damage(x0, y0, x1 - x0, y1 - y0);
+    return;
+  }
+
+  for (int i = 0; i < a.count; i++) {
+    const DlCmd &ca = a.cmds[i];
+    const DlCmd &cb = b.cmds[i];
+    if (sameCmd(a, ca, b, cb) || textSpan(a, ca, b, cb, metrics, damage))
+      continue;
+    damage(ca.bx, ca.by, ca.bw, ca.bh);
+    damage(cb.bx, cb.by, cb.bw, cb.bh);
+  }
+}
+
+// ============================================================
+// Patch — replay the new list into the damage
+// ============================================================
+static const DisplayList *patchList = nullptr;
+static LGFX_Sprite *patchCanvas = nullptr;
+
+static void patchDamage(int x, int y, int w, int h) {
+  replayClip(*patchList, *patchCanvas, patchCanvas, x, y, w, h);
+  dirtyAdd(x, y, w, h);
+}
+
+void dlPatch(DisplayList &shown, const DisplayList &next,
+             LGFX_Sprite &canvas) {
+  patchList = &next;
+  patchCanvas = &canvas;
+  dlDiff(shown, next, canvas, patchDamage);
+  shown = next;
+}
+
+// ============================================================
+// Dump
+// ============================================================
+void dlDump(const DisplayList &dl) {
+  static const char *const names[] = {"fillScreen", "fillRect",
+                                      "drawRect",   "fillRoundRect",
+                                      "drawRoundRect", "fillCircle",
+                                      "hline",      "vline",
+                                      "text",       "softRoundRect",
+                                      "softShadow", "image"};
+  Serial.printf("[DList] %d cmds, %d text bytes%s\n", dl.count, dl.textUsed,
+                dl.overflow ? " (overflow)" : "");
+  for (int i = 0; i < dl.count; i++) {
+    const DlCmd &c = dl.cmds[i];
+    if (c.op == DL_TEXT)
+      Serial.printf("  %-13s (%d,%d) datum %d fg %04X bg %04X \"%s\"\n",
+                    names[c.op], c.x, c.y, c.datum, c.color, c.bg,
+                    dl.text + c.text);
+    else
+      Serial.printf("  %-13s (%d,%d %dx%d r%d) %04X\n", names[c.op], c.x,
+                    c.y, c.w, c.h, c.r, c.color);
+  }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+struct Asset;
+
+// ============================================================
+// Display lists
+// A recorded sequence of draw commands (fills, rects, round rects,
+// circles, lines, text) with their parameters. A list can be replayed
+// onto any LovyanGFX sprite or panel, and two lists can be diffed into
+// the area whose pixels differ — redrawing a live region is then
+// "record the new list, replay it clipped to the diff".
+// A list that is patched must paint its own background (start with a
+// fillRect), since only its commands are replayed into the damage.
+// ============================================================
+#define DL_MAX_CMDS 32
+#define DL_TEXT_BYTES 256
+
+enum DlOp : uint8_t {
+  DL_FILL_SCREEN,
+  DL_FILL_RECT,
+  DL_DRAW_RECT,
+  DL_FILL_ROUND_RECT,
+  DL_DRAW_ROUND_RECT,
+  DL_FILL_CIRCLE,
+  DL_HLINE,
+  DL_VLINE,
+  DL_TEXT,
+  DL_SOFT_ROUND_RECT,
+  DL_SOFT_SHADOW,
+  DL_IMAGE
+};
+
+struct DlCmd {
+  DlOp op;
+  uint8_t datum;            // text; soft shadow: blur radius
+  int16_t x, y, w, h, r;    // shape; text anchor is (x, y)
+  uint16_t color, bg;       // text: bg == color is transparent
+  uint16_t text, len;       // text: offset into the list's string pool
+  union {
+    const lgfx::IFont *font; // text
+    const Asset *image;      // image
+  };
+  int16_t bx, by, bw, bh;   // pixels the command can touch
+};
+
+struct DisplayList {
+  DlCmd cmds[DL_MAX_CMDS];
+  char text[DL_TEXT_BYTES];
+  uint16_t count, textUsed;
+  bool overflow; // ran out of room: diffs against it damage everything
+};
+
+// --- Recording (usually through DirtySprite::recordBegin) ---
+void dlClear(DisplayList &dl);
+void dlRecord(DisplayList &dl, DlOp op, int x, int y, int w, int h, int r,
+              uint16_t color);
+void dlRecordShadow(DisplayList &dl, int x, int y, int w, int h, int r,
+                    int blur, uint16_t color);
+void dlRecordImage(DisplayList &dl, const Asset &image, int x, int y);
+// Font and datum are taken from `gfx`
+void dlRecordText(DisplayList &dl, lgfx::LGFXBase &gfx, const char *str,
+                  int x, int y, uint16_t fg, uint16_t bg);
+
+// --- Replay ---
+// Soft shapes and images need a 16-bit sprite; on other targets soft
+// shapes replay as plain round rects and images are left out
+void dlReplay(const DisplayList &dl, lgfx::LGFXBase &gfx);
+void dlReplayClip(const DisplayList &dl, lgfx::LGFXBase &gfx, int x, int y,
+                  int w, int h); // only commands touching the clip
+
+// --- Diff ---
+// Reports the damaged area between `a` and `b` as rectangles. Equal
+// commands cost nothing; equal-width strings in the same style (clock
+// digits) only damage the run of characters that changed. `metrics`
+// supplies text widths.
+typedef void (*DlDamage)(int x, int y, int w, int h);
+void dlDiff(const DisplayList &a, const DisplayList &b,
+            lgfx::LGFXBase &metrics, DlDamage damage);
+
+// Diffs `shown` against `next`, replays `next` into the damage on the
+// canvas (opaque text from the glyph cache), marks it dirty and makes
+// `next` the shown list
+void dlPatch(DisplayList &shown, const DisplayList &next,
+             LGFX_Sprite &canvas);
+
+void dlDump(const DisplayList &dl); // one command per line on Serial
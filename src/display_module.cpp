@@ -1,9 +1,22 @@
 #include "display_module.h"
+#include "dirty_rect.h"
+#include "pixel_kernels.h"
+#include "profiler.h"
 #include <Wire.h>
+#include <esp_heap_caps.h>
 
 // ============================================================
-// LovyanGFX Configuration
+// LovyanGFX Display Class for ST7796S SPI + FT6236 I2C Touch
 // ============================================================
+class LGFX : public lgfx::LGFX_Device {
+  lgfx::Panel_ST7796 _panel_instance;
+  lgfx::Bus_SPI _bus_instance;
+  lgfx::Touch_FT5x06 _touch_instance;
+
+public:
+  LGFX(void);
+};
+
 LGFX::LGFX(void) {
   // --- SPI Bus ---
   {
@@ -72,8 +85,12 @@ LGFX::LGFX(void) {
 // ============================================================
 static LGFX display;
 
+// Bus traffic accounting, reported per second by `prof`
+static uint32_t bytesThisSecond = 0;
+static unsigned long byteWindowStartMs = 0;
+
 // ============================================================
-LGFX &getDisplay(void) { return display; }
+lgfx::LGFX_Device &getDisplay(void) { return display; }
 
 // ============================================================
 // displaySetup
@@ -99,5 +116,195 @@ void displaySetup(void) {
                 display.height());
 }
 
-// displayLoop — no longer used (ui_manager handles everything)
-void displayLoop(void) {}
+// ============================================================
+// Strip-streamed frame pipeline
+// ============================================================
+static const uint8_t *frame = nullptr;       // canvas pixels (PSRAM)
+static uint16_t *strip[2] = {nullptr, nullptr}; // DMA bounce (internal)
+static bool inflight = false;
+static DirtyRect inflightRects[DIRTY_MAX_RECTS];
+static int inflightCount = 0;
+static int queueRect = 0, queueRow = 0; // next band to copy
+static int stripFill = 0;               // strip the next band goes into
+static bool stripReady = false;         // strip[stripFill] holds a band
+static int16_t bandX, bandY, bandW, bandH;
+static uint32_t inflightStamp = 0; // profiler: damage handed to the bus
+static uint16_t lut[256];          // palette index -> byte-swapped RGB565
+
+void displaySetPalette(const uint16_t *rgb565, int count) {
+  for (int i = 0; i < 256; i++) {
+    uint16_t c = i < count ? rgb565[i] : 0;
+    lut[i] = (uint16_t)((c << 8) | (c >> 8)); // panel byte order
+  }
+}
+
+void displayFramesSetup(LGFX_Sprite &canvas) {
+  canvas.setPsram(true);
+  if (!canvas.createSprite(LCD_WIDTH, LCD_HEIGHT)) {
+    Serial.println("[Display] Canvas alloc failed");
+    return;
+  }
+  size_t len = LCD_WIDTH * DISPLAY_STRIP_LINES * sizeof(uint16_t);
+  strip[0] = (uint16_t *)heap_caps_malloc(len, MALLOC_CAP_DMA |
+                                                   MALLOC_CAP_INTERNAL);
+  strip[1] = (uint16_t *)heap_caps_malloc(len, MALLOC_CAP_DMA |
+                                                   MALLOC_CAP_INTERNAL);
+  if (!strip[0] || !strip[1]) {
+    // Fall back to pushing the canvas synchronously
+    Serial.println("[Display] Strip alloc failed — synchronous push");
+    heap_caps_free(strip[0]);
+    heap_caps_free(strip[1]);
+    strip[0] = strip[1] = nullptr;
+    return;
+  }
+  Serial.printf("[Display] Canvas in PSRAM, 2 x %u B DMA strips in SRAM\n",
+                (unsigned)len);
+}
+
+// Next band of the queued damage: up to one strip of pixels, so narrow
+// regions move more rows per transfer
+static bool nextBand(void) {
+  while (queueRect < inflightCount) {
+    const DirtyRect &r = inflightRects[queueRect];
+    if (queueRow < r.h) {
+      int rows = LCD_WIDTH * DISPLAY_STRIP_LINES / r.w;
+      if (rows > r.h - queueRow)
+        rows = r.h - queueRow;
+      bandX = r.x;
+      bandY = r.y + queueRow;
+      bandW = r.w;
+      bandH = rows;
+      queueRow += rows;
+      return true;
+    }
+    queueRect++;
+    queueRow = 0;
+  }
+  return false;
+}
+
+// Copy the next band out of the canvas into the free strip, expanding
+// palette indices to RGB565 on the way
+static void prepareStrip(void) {
+  if (stripReady || !nextBand())
+    return;
+  uint16_t *dst = strip[stripFill];
+  for (int row = 0; row < bandH; row++, dst += bandW) {
+    size_t line = (size_t)(bandY + row) * LCD_WIDTH;
+#if UI_CANVAS_BPP == 16
+    pixCopy(dst, (const uint16_t *)frame + line + bandX, bandW);
+#elif UI_CANVAS_BPP == 8
+    const uint8_t *src = frame + line + bandX;
+    for (int i = 0; i < bandW; i++)
+      dst[i] = lut[src[i]];
+#else
+    // Two pixels per byte, left pixel in the high nibble
+    int x = bandX;
+    const uint8_t *src = frame + (line + x) / 2;
+    int i = 0;
+    if (x & 1)
+      dst[i++] = lut[*src++ & 0x0F];
+    for (; i + 1 < bandW; i += 2, src++) {
+      dst[i] = lut[*src >> 4];
+      dst[i + 1] = lut[*src & 0x0F];
+    }
+    if (i < bandW)
+      dst[i] = lut[*src >> 4];
+#endif
+  }
+  stripReady = true;
+}
+
+// Start the prepared strip once the bus is free, then fill the other one
+// while it transfers; ends the SPI transaction after the last band.
+static void pumpDMA(void) {
+  if (!inflight || display.dmaBusy())
+    return;
+
+  if (stripReady) {
+    display.pushImageDMA(bandX, bandY, bandW, bandH,
+                         (const lgfx::swap565_t *)strip[stripFill]);
+    bytesThisSecond += (uint32_t)bandW * bandH * 2;
+    stripFill ^= 1;
+    stripReady = false;
+    prepareStrip();
+    return;
+  }
+
+  display.endWrite();
+  inflight = false;
+  profEnd(PROF_PUSH, inflightStamp);
+}
+
+bool displayBusy(void) {
+  pumpDMA();
+  return inflight;
+}
+
+void displayWait(void) {
+  while (displayBusy()) {
+    display.waitDMA();
+  }
+}
+
+// ============================================================
+// displayPresent — hand the canvas damage to the strip pump
+// ============================================================
+void displayPresent(LGFX_Sprite &canvas) {
+  if (dirtyCount() == 0)
+    return;
+
+  if (!strip[0]) {
+    uint32_t stamp = profStamp();
+    for (int i = 0; i < dirtyCount(); i++) {
+      const DirtyRect &r = dirtyGet(i);
+      display.setClipRect(r.x, r.y, r.w, r.h);
+      canvas.pushSprite(&display, 0, 0);
+      bytesThisSecond += (uint32_t)r.w * r.h * 2;
+      profRecord(PROF_PUSH_BYTES, (uint32_t)r.w * r.h * 2);
+    }
+    display.clearClipRect();
+    dirtyClear();
+    profEnd(PROF_PUSH, stamp);
+    return;
+  }
+
+  // One batch on the bus at a time; damage keeps accumulating until then.
+  // Pixels redrawn after their band was copied are in that new damage.
+  if (displayBusy())
+    return;
+
+  uint32_t stamp = profStamp();
+  frame = (const uint8_t *)canvas.getBuffer();
+  inflightCount = dirtyCount();
+  uint32_t frameBytes = 0;
+  for (int i = 0; i < inflightCount; i++) {
+    inflightRects[i] = dirtyGet(i);
+    frameBytes += (uint32_t)inflightRects[i].w * inflightRects[i].h * 2;
+  }
+  profRecord(PROF_PUSH_BYTES, frameBytes);
+  dirtyClear();
+
+  queueRect = queueRow = 0;
+  stripReady = false;
+  prepareStrip();
+  inflight = true;
+  display.startWrite();
+  inflightStamp = profStamp();
+  pumpDMA();
+  profEnd(PROF_PRESENT, stamp);
+}
+
+// ============================================================
+// displayLoop — feeds the DMA queue, rolls the bytes/s counter
+// ============================================================
+void displayLoop(void) {
+  pumpDMA();
+
+  if (millis() - byteWindowStartMs < 1000)
+    return;
+  byteWindowStartMs = millis();
+  if (bytesThisSecond > 0)
+    profRecord(PROF_PUSH_RATE, (bytesThisSecond + 512) / 1024);
+  bytesThisSecond = 0;
+}
@@ -3,19 +3,22 @@
 #include "config.h"
 #include <LovyanGFX.hpp>
 
-// ============================================================
-// LovyanGFX Display Class for ST7796S SPI + FT6236 I2C Touch
-// ============================================================
-class LGFX : public lgfx::LGFX_Device {
-  lgfx::Panel_ST7796 _panel_instance;
-  lgfx::Bus_SPI _bus_instance;
-  lgfx::Touch_FT5x06 _touch_instance;
-
-public:
-  LGFX(void);
-};
-
 // --- Public API ---
+// The panel wiring (ST7796S on SPI, FT6236 touch on I2C) stays in
+// display_module.cpp, so the UI builds on any LovyanGFX platform
 void displaySetup(void);
 void displayLoop(void);
-LGFX &getDisplay(void);
+lgfx::LGFX_Device &getDisplay(void);
+
+// --- Strip-streamed DMA frame pipeline ---
+// The canvas is one retained frame in PSRAM. Damaged regions are copied
+// band by band into two small internal-SRAM strips and DMA'd out; the
+// next strip is filled while the current one is on the bus.
+void displayFramesSetup(LGFX_Sprite &canvas); // allocate canvas + strips
+void displayPresent(LGFX_Sprite &canvas); // queue damage (deferred if busy)
+bool displayBusy(void);                   // damage still being clocked out
+void displayWait(void);                   // block until it is on the panel
+
+// Palette-indexed canvas (UI_CANVAS_BPP 4 / 8): indices are expanded to
+// RGB565 through this table while each strip is filled
+void displaySetPalette(const uint16_t *rgb565, int count);
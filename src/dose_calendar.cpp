@@ -0,0 +1,253 @@
+#include "dose_calendar.h"
+#include "profiler.h"
+
+// ============================================================
+// Heap
+// ============================================================
+static inline uint32_t key(const DoseCalendar &cal, int i) {
+  return cal.rules[cal.heap[i]].next;
+}
+
+static inline void place(DoseCalendar &cal, int i, uint16_t id) {
+  cal.heap[i] = id;
+  cal.rules[id].pos = i;
+}
+
+static void siftUp(DoseCalendar &cal, int i) {
+  uint16_t id = cal.heap[i];
+  uint32_t k = cal.rules[id].next;
+  while (i > 0) {
+    int parent = (i - 1) / 2;
+    if (key(cal, parent) <= k)
+      break;
+    place(cal, i, cal.heap[parent]);
+    i = parent;
+  }
+  place(cal, i, id);
+}
+
+static void siftDown(DoseCalendar &cal, int i) {
+  uint16_t id = cal.heap[i];
+  uint32_t k = cal.rules[id].next;
+  for (;;) {
+    int child = 2 * i + 1;
+    if (child >= cal.queued)
+      break;
+    if (child + 1 < cal.queued && key(cal, child + 1) < key(cal, child))
+      child++;
+    if (k <= key(cal, child))
+      break;
+    place(cal, i, cal.heap[child]);
+    i = child;
+  }
+  place(cal, i, id);
+}
+
+static void enqueue(DoseCalendar &cal, int id) {
+  place(cal, cal.queued++, id);
+  siftUp(cal, cal.queued - 1);
+}
+
+static void dequeue(DoseCalendar &cal, int id) {
+  int i = cal.rules[id].pos;
+  cal.rules[id].pos = CAL_NONE;
+  if (--cal.queued == i)
+    return;
+  uint16_t moved = cal.heap[cal.queued]; // last entry into the hole
+  place(cal, i, moved);
+  siftUp(cal, i);
+  siftDown(cal, cal.rules[moved].pos);
+}
+
+// ============================================================
+// Recurrence
+// ============================================================
+uint32_t calNextAfter(const DoseRule &r, uint32_t after) {
+  if (!(r.days & CAL_EVERY_DAY))
+    return 0;
+  if (r.period == 0)
+    return r.start > after && (r.days & (1 << calWeekday(r.start)))
+               ? r.start
+               : 0;
+  if (r.period < 60)
+    return 0;
+  uint32_t t = r.start;
+  if (after >= t)
+    t += ((after - t) / r.period + 1) * r.period;
+  // The weekdays repeat after week / gcd(period, week) steps, so that
+  // many cover every weekday the rule can land on (7 for 48 h, 168 for
+  // 25 h); the first allowed one usually comes far earlier
+  uint32_t a = r.period, b = CAL_WEEK;
+  while (b) {
+    uint32_t c = a % b;
+    a = b;
+    b = c;
+  }
+  for (uint32_t n = CAL_WEEK / a; n; n--) {
+    if (r.days & (1 << calWeekday(t)))
+      return t;
+    t += r.period;
+  }
+  return 0;
+}
+
+static void plan(DoseCalendar &cal, int id, uint32_t now) {
+  DoseRule &r = cal.rules[id];
+  bool live = r.enabled && r.modules;
+  r.next = live ? calNextAfter(r, now) : 0;
+  bool want = r.next != 0;
+  if (r.pos != CAL_NONE && !want) {
+    dequeue(cal, id);
+  } else if (r.pos == CAL_NONE && want) {
+    enqueue(cal, id);
+  } else if (want) {
+    siftUp(cal, r.pos);
+    siftDown(cal, r.pos);
+  }
+}
+
+// ============================================================
+// Public API
+// ============================================================
+void calInit(DoseCalendar &cal, DoseRule *rules, uint16_t *heap,
+             uint16_t cap) {
+  cal.rules = rules;
+  cal.heap = heap;
+  cal.cap = cap;
+  cal.count = 0;
+  cal.queued = 0;
+}
+
+int calAdd(DoseCalendar &cal, const DoseRule &rule, uint32_t now) {
+  if (cal.count >= cal.cap)
+    return -1;
+  int id = cal.count++;
+  cal.rules[id] = rule;
+  cal.rules[id].pos = CAL_NONE;
+  plan(cal, id, now);
+  return id;
+}
+
+void calUpdate(DoseCalendar &cal, int id, uint32_t now) {
+  if (id >= 0 && id < cal.count)
+    plan(cal, id, now);
+}
+
+void calRemove(DoseCalendar &cal, int id) {
+  if (id < 0 || id >= cal.count)
+    return;
+  if (cal.rules[id].pos != CAL_NONE)
+    dequeue(cal, id);
+  int last = --cal.count;
+  if (id == last)
+    return;
+  cal.rules[id] = cal.rules[last];
+  if (cal.rules[id].pos != CAL_NONE)
+    cal.heap[cal.rules[id].pos] = id;
+}
+
+void calRebuild(DoseCalendar &cal, uint32_t now) {
+  cal.queued = 0;
+  for (int id = 0; id < cal.count; id++) {
+    DoseRule &r = cal.rules[id];
+    r.pos = CAL_NONE;
+    r.next = r.enabled && r.modules ? calNextAfter(r, now) : 0;
+    if (r.next)
+      place(cal, cal.queued++, id);
+  }
+  for (int i = cal.queued / 2 - 1; i >= 0; i--)
+    siftDown(cal, i);
+}
+
+const DoseRule *calPeek(const DoseCalendar &cal) {
+  return cal.queued ? &cal.rules[cal.heap[0]] : nullptr;
+}
+
+int calTake(DoseCalendar &cal) {
+  if (!cal.queued)
+    return -1;
+  int id = cal.heap[0];
+  plan(cal, id, cal.rules[id].next);
+  return id;
+}
+
+// ============================================================
+// Benchmark — random rules on a scratch calendar
+// ============================================================
+static uint32_t xorshift(uint32_t &s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+// Heap order, positions, and the top against a linear scan
+static bool calCheck(const DoseCalendar &cal) {
+  uint32_t min = 0xFFFFFFFF;
+  for (int id = 0; id < cal.count; id++) {
+    const DoseRule &r = cal.rules[id];
+    if (r.pos == CAL_NONE)
+      continue;
+    if (cal.heap[r.pos] != id)
+      return false;
+    if (r.pos && key(cal, (r.pos - 1) / 2) > r.next)
+      return false;
+    min = r.next < min ? r.next : min;
+  }
+  return !cal.queued || key(cal, 0) == min;
+}
+
+void calBench(void) {
+  static const uint16_t sizes[] = {10, 100, 1000};
+  static const uint32_t periods[] = {CAL_DAILY, 12 * 3600, 8 * 3600,
+                                     6 * 3600, CAL_WEEK};
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  uint32_t now = 1767225600UL; // 2026-01-01
+  for (uint16_t n : sizes) {
+    DoseRule *rules = (DoseRule *)malloc(n * sizeof(DoseRule));
+    uint16_t *heap = (uint16_t *)malloc(n * sizeof(uint16_t));
+    if (!rules || !heap) {
+      Serial.println("[Cal] Out of memory");
+      free(rules);
+      free(heap);
+      return;
+    }
+    DoseCalendar cal;
+    calInit(cal, rules, heap, n);
+    uint32_t s = 0x9E3779B9u;
+
+    uint32_t t = profStamp();
+    for (int i = 0; i < n; i++) {
+      DoseRule r = {};
+      r.start = (xorshift(s) % 1440) * 60;
+      r.period = periods[xorshift(s) % 5];
+      r.days = (xorshift(s) & CAL_EVERY_DAY) | 1;
+      r.modules = 1 << (i % NUM_MODULES);
+      r.slot = -1;
+      r.enabled = true;
+      calAdd(cal, r, now);
+    }
+    uint32_t addCycles = profStamp() - t;
+
+    const int peeks = 10000;
+    volatile uint32_t sink = 0;
+    t = profStamp();
+    for (int i = 0; i < peeks; i++)
+      sink += calPeek(cal)->next;
+    uint32_t peekCycles = profStamp() - t;
+
+    t = profStamp();
+    for (int i = 0; i < n; i++)
+      calTake(cal);
+    uint32_t takeCycles = profStamp() - t;
+
+    Serial.printf("[Cal] %4d rules: insert %6.2f us  peek %5.3f us  "
+                  "take %6.2f us  %s\n",
+                  n, (float)addCycles / mhz / n,
+                  (float)peekCycles / mhz / peeks,
+                  (float)takeCycles / mhz / n,
+                  calCheck(cal) ? "heap ok" : "HEAP BROKEN");
+    free(rules);
+    free(heap);
+  }
+}
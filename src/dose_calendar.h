@@ -0,0 +1,59 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Dose calendar
+// Recurring dose rules plus a binary min-heap holding each queued
+// rule's next occurrence. Recurrences are expanded lazily: a rule has
+// exactly one occurrence in the heap, and taking it computes the one
+// after. The next dose is the heap top (O(1)); add, update, remove and
+// take are O(log n). Times are epoch seconds of the RTC's local time,
+// so epoch % 86400 is the time of day.
+// calBench() times insert / peek / take at 10, 100 and 1000 rules.
+// ============================================================
+#define CAL_DAILY 86400UL
+#define CAL_WEEK (7 * CAL_DAILY)
+#define CAL_EVERY_DAY 0x7F
+#define CAL_NONE 0xFFFF
+
+struct DoseRule {
+  uint32_t start;  // an occurrence (epoch); daily rules: seconds of day
+  uint32_t period; // seconds between occurrences, >= 60; 0 = once
+  uint32_t next;   // queued occurrence, 0 = none
+  uint16_t pos;    // heap index, CAL_NONE when not queued
+  uint8_t days;    // weekdays it may fall on, bit 0 = Sunday
+  uint8_t modules; // modules dispensed, bit 0 = module 1
+  int8_t slot;     // meal-grid slot it mirrors; <0: own time, regimen
+  bool enabled;
+};
+
+struct DoseCalendar {
+  DoseRule *rules; // `cap` entries, ids 0..count-1
+  uint16_t *heap;  // rule ids, earliest `next` first
+  uint16_t cap, count, queued;
+};
+
+void calInit(DoseCalendar &cal, DoseRule *rules, uint16_t *heap,
+             uint16_t cap);
+
+// Rules are queued when enabled, dispensing something and falling on
+// at least one allowed weekday
+int calAdd(DoseCalendar &cal, const DoseRule &rule, uint32_t now); // id/-1
+void calUpdate(DoseCalendar &cal, int id, uint32_t now); // after editing
+void calRemove(DoseCalendar &cal, int id); // the last rule takes its id
+void calRebuild(DoseCalendar &cal, uint32_t now); // clock stepped
+
+const DoseRule *calPeek(const DoseCalendar &cal); // next dose or nullptr
+int calTake(DoseCalendar &cal); // dequeues the top, queues its next one
+
+// First occurrence of `rule` strictly after `after`, 0 if none. A rule
+// with period 0 occurs once, at `start`: to reuse it, set a new start
+// and calUpdate().
+uint32_t calNextAfter(const DoseRule &rule, uint32_t after);
+
+inline uint8_t calWeekday(uint32_t epoch) { // 0 = Sunday
+  return (epoch / 86400 + 4) % 7;          // 1970-01-01 was a Thursday
+}
+
+void calBench(void); // `cal bench`, on scratch calendars
@@ -0,0 +1,2 @@
+// Generated by build_fonts.py — do not edit
+#include "font_data.h"
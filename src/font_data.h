@@ -0,0 +1,11 @@
+#pragma once
+// Generated by build_fonts.py — do not edit
+#include <LovyanGFX.hpp>
+
+// FreeSansBold24pt7b: source not found, not subset
+#define FONT_CLOCK (&fonts::FreeSansBold24pt7b)
+// thaiFont14: source not found, not subset
+// thaiFont16: source not found, not subset
+// thaiFont24: source not found, not subset
+
+// sources:
@@ -0,0 +1,151 @@
+#include "gesture.h"
+
+// ============================================================
+// Output queue
+// ============================================================
+static Gesture queue[GESTURE_QUEUE];
+static uint8_t qHead = 0, qTail = 0;
+
+static void emit(const Gesture &g) {
+  if ((uint8_t)(qHead - qTail) >= GESTURE_QUEUE)
+    qTail++; // drop the oldest
+  queue[qHead % GESTURE_QUEUE] = g;
+  qHead++;
+}
+
+bool gestureNext(Gesture &g) {
+  if (qTail == qHead)
+    return false;
+  g = queue[qTail % GESTURE_QUEUE];
+  qTail++;
+  return true;
+}
+
+// ============================================================
+// Tracking state for the current finger
+// ============================================================
+#define VELOCITY_WINDOW_MS 80
+
+static bool down = false;
+static bool moved = false; // left the slop circle
+static int16_t startX, startY;
+static uint32_t pressMs;
+static bool repeatArmed = false; // gestureArmRepeat() for this press
+static uint16_t repeatCount;
+static uint32_t nextRepeatMs;
+static uint32_t repeatInterval;
+
+// Recent samples for release velocity
+struct Sample {
+  int16_t x, y;
+  uint32_t t;
+};
+static Sample hist[4];
+static uint8_t histLen = 0;
+
+static void addSample(int x, int y, uint32_t t) {
+  if (histLen == 4) {
+    memmove(hist, hist + 1, 3 * sizeof(Sample));
+    histLen = 3;
+  }
+  hist[histLen++] = {(int16_t)x, (int16_t)y, t};
+}
+
+static float releaseSpeed(void) {
+  if (histLen < 2)
+    return 0;
+  const Sample &last = hist[histLen - 1];
+  int i = 0;
+  while (i < histLen - 2 && last.t - hist[i].t > VELOCITY_WINDOW_MS)
+    i++;
+  uint32_t dt = last.t - hist[i].t;
+  if (dt == 0)
+    return 0;
+  float dx = last.x - hist[i].x, dy = last.y - hist[i].y;
+  return sqrtf(dx * dx + dy * dy) / dt;
+}
+
+static Gesture make(GestureType type) {
+  Gesture g = {};
+  g.type = type;
+  g.x = startX;
+  g.y = startY;
+  return g;
+}
+
+// ============================================================
+void gestureFeed(const TouchEvent &ev) {
+  switch (ev.phase) {
+  case TOUCH_PRESS:
+    down = true;
+    moved = false;
+    startX = ev.x;
+    startY = ev.y;
+    pressMs = ev.timeMs;
+    repeatArmed = false;
+    repeatCount = 0;
+    repeatInterval = REPEAT_START_MS;
+    nextRepeatMs = pressMs + LONG_PRESS_MS;
+    histLen = 0;
+    addSample(ev.x, ev.y, ev.timeMs);
+    emit(make(GESTURE_PRESS));
+    break;
+
+  case TOUCH_MOVE:
+    if (!down)
+      break;
+    addSample(ev.x, ev.y, ev.timeMs);
+    if (abs(ev.x - startX) > GESTURE_SLOP_PX ||
+        abs(ev.y - startY) > GESTURE_SLOP_PX)
+      moved = true; // dragging — no tap, no repeat
+    break;
+
+  case TOUCH_RELEASE: {
+    if (!down)
+      break;
+    down = false;
+    addSample(ev.x, ev.y, ev.timeMs);
+    int dx = ev.x - startX, dy = ev.y - startY;
+
+    if (abs(dx) >= SWIPE_MIN_PX || abs(dy) >= SWIPE_MIN_PX) {
+      Gesture g = make(GESTURE_SWIPE);
+      g.dx = dx;
+      g.dy = dy;
+      if (abs(dx) >= abs(dy))
+        g.dir = dx < 0 ? SWIPE_LEFT : SWIPE_RIGHT;
+      else
+        g.dir = dy < 0 ? SWIPE_UP : SWIPE_DOWN;
+      g.speed = releaseSpeed();
+      g.flick = g.speed >= FLICK_MIN_SPEED;
+      emit(g);
+    } else if (!moved && repeatCount == 0) {
+      emit(make(GESTURE_TAP));
+    }
+    break;
+  }
+  }
+}
+
+void gestureArmRepeat(void) { repeatArmed = down; }
+
+// ============================================================
+// Long-press auto-repeat: fires at LONG_PRESS_MS, then every interval,
+// the interval shrinking by REPEAT_ACCEL_PCT down to REPEAT_MIN_MS.
+// Only for presses the UI armed (auto-repeat widgets).
+// ============================================================
+void gestureLoop(void) {
+  if (!down || moved || !repeatArmed)
+    return;
+  uint32_t now = millis();
+  if ((int32_t)(now - nextRepeatMs) < 0)
+    return;
+
+  Gesture g = make(GESTURE_REPEAT);
+  g.repeat = ++repeatCount;
+  emit(g);
+
+  nextRepeatMs = now + repeatInterval;
+  repeatInterval = repeatInterval * REPEAT_ACCEL_PCT / 100;
+  if (repeatInterval < REPEAT_MIN_MS)
+    repeatInterval = REPEAT_MIN_MS;
+}
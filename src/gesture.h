@@ -0,0 +1,48 @@
+#pragma once
+#include "touch_input.h"
+#include <Arduino.h>
+
+// ============================================================
+// Gesture recognizer — turns the raw touch stream into taps, swipes,
+// flicks and long-press auto-repeat with accelerating cadence.
+// ============================================================
+#define GESTURE_QUEUE 8
+#define GESTURE_SLOP_PX 12      // movement that cancels tap / long-press
+#define SWIPE_MIN_PX 40         // minimum travel for a swipe
+#define FLICK_MIN_SPEED 0.8f    // px/ms at release for a flick
+#define LONG_PRESS_MS 450       // hold time before the first repeat
+#define REPEAT_START_MS 220     // first auto-repeat interval
+#define REPEAT_MIN_MS 40        // fastest auto-repeat interval
+#define REPEAT_ACCEL_PCT 80     // each interval = previous * 80%
+
+enum GestureType : uint8_t {
+  GESTURE_PRESS,  // finger down (fires immediately)
+  GESTURE_TAP,    // released near the press point, unless it repeated
+  GESTURE_REPEAT, // held and armed: repeat 1 = long-press, then faster
+  GESTURE_SWIPE   // released after travelling >= SWIPE_MIN_PX
+};
+
+enum SwipeDir : uint8_t {
+  SWIPE_NONE,
+  SWIPE_LEFT,
+  SWIPE_RIGHT,
+  SWIPE_UP,
+  SWIPE_DOWN
+};
+
+struct Gesture {
+  GestureType type;
+  SwipeDir dir;
+  bool flick;      // swipe released faster than FLICK_MIN_SPEED
+  int16_t x, y;    // press point
+  int16_t dx, dy;  // total travel (swipe)
+  uint16_t repeat; // repeat count (GESTURE_REPEAT)
+  float speed;     // release speed in px/ms (swipe)
+};
+
+void gestureFeed(const TouchEvent &ev);
+void gestureLoop(void); // emits time-based repeats while a finger is held
+// Called on GESTURE_PRESS when the press is on an auto-repeat widget;
+// other presses never repeat, so a long hold still ends in a tap
+void gestureArmRepeat(void);
+bool gestureNext(Gesture &g);
@@ -0,0 +1,277 @@
+#include "glyph_cache.h"
+#include "pixel_kernels.h"
+#include <esp_heap_caps.h>
+
+// ============================================================
+// Cells + hash chains
+// ============================================================
+#define GLYPH_BUCKETS 256
+#define GLYPH_NONE -1
+
+struct GlyphCell {
+  const lgfx::IFont *font;
+  uint64_t code; // up to 4 BMP codepoints, base in the low 16 bits
+  uint16_t fg, bg;
+  uint8_t w, h;
+  bool pinned;
+  int16_t next;     // hash chain
+  uint32_t lastUse; // LRU clock
+  uint16_t *pixels; // w * h, sprite byte order
+};
+
+static GlyphCell cells[GLYPH_CACHE_SLOTS];
+static int16_t buckets[GLYPH_BUCKETS];
+static int16_t freeList = GLYPH_NONE;
+static size_t budget = 0;
+static size_t usedBytes = 0;
+static uint32_t useClock = 0;
+static uint32_t hits = 0, misses = 0;
+static bool ready = false;
+
+static LGFX_Sprite scratch; // rasterizer, internal RAM
+
+void glyphCacheSetup(size_t budgetBytes) {
+  budget = budgetBytes;
+  for (int i = 0; i < GLYPH_BUCKETS; i++)
+    buckets[i] = GLYPH_NONE;
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    cells[i].pixels = nullptr;
+    cells[i].next = (i + 1 < GLYPH_CACHE_SLOTS) ? i + 1 : GLYPH_NONE;
+  }
+  freeList = 0;
+  scratch.setColorDepth(16);
+  ready = true;
+  Serial.printf("[Glyph] Cache ready, %u KB budget\n",
+                (unsigned)(budget / 1024));
+}
+
+static int bucketOf(const lgfx::IFont *font, uint64_t code, uint16_t fg,
+                    uint16_t bg) {
+  uint32_t h = (uint32_t)(uintptr_t)font * 2654435761u;
+  h ^= (uint32_t)code * 40503u ^ (uint32_t)(code >> 32);
+  h ^= ((uint32_t)fg << 16 | bg) * 2246822519u;
+  return (h >> 8) % GLYPH_BUCKETS;
+}
+
+static int findCell(const lgfx::IFont *font, uint64_t code, uint16_t fg,
+                    uint16_t bg) {
+  for (int i = buckets[bucketOf(font, code, fg, bg)]; i != GLYPH_NONE;
+       i = cells[i].next) {
+    const GlyphCell &c = cells[i];
+    if (c.code == code && c.font == font && c.fg == fg && c.bg == bg)
+      return i;
+  }
+  return GLYPH_NONE;
+}
+
+static void unlinkCell(int id) {
+  GlyphCell &c = cells[id];
+  int16_t *p = &buckets[bucketOf(c.font, c.code, c.fg, c.bg)];
+  while (*p != GLYPH_NONE && *p != id)
+    p = &cells[*p].next;
+  if (*p == id)
+    *p = c.next;
+}
+
+// Drop the least recently used unpinned cell. False if all are pinned.
+static bool evictOne(void) {
+  int victim = GLYPH_NONE;
+  for (int i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+    const GlyphCell &c = cells[i];
+    if (!c.pixels || c.pinned)
+      continue;
+    if (victim == GLYPH_NONE || c.lastUse < cells[victim].lastUse)
+      victim = i;
+  }
+  if (victim == GLYPH_NONE)
+    return false;
+  GlyphCell &c = cells[victim];
+  unlinkCell(victim);
+  usedBytes -= (size_t)c.w * c.h * 2;
+  heap_caps_free(c.pixels);
+  c.pixels = nullptr;
+  c.next = freeList;
+  freeList = victim;
+  return true;
+}
+
+// ============================================================
+// UTF-8 clusters
+// ============================================================
+static int decodeUtf8(const char *s, uint32_t &cp) {
+  uint8_t b = s[0];
+  if (b < 0x80) {
+    cp = b;
+    return 1;
+  }
+  if ((b & 0xE0) == 0xC0 && s[1]) {
+    cp = ((b & 0x1F) << 6) | (s[1] & 0x3F);
+    return 2;
+  }
+  if ((b & 0xF0) == 0xE0 && s[1] && s[2]) {
+    cp = ((b & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    return 3;
+  }
+  cp = '?';
+  return 1;
+}
+
+// Thai above/below vowels and tone marks — zero advance, drawn over
+// the preceding base character
+static bool isCombining(uint32_t cp) {
+  return cp == 0x0E31 || (cp >= 0x0E34 && cp <= 0x0E3A) ||
+         (cp >= 0x0E47 && cp <= 0x0E4E);
+}
+
+// Reads one cluster starting at s: returns its byte length and key
+static int nextCluster(const char *s, uint64_t &code) {
+  uint32_t cp;
+  int len = decodeUtf8(s, cp);
+  code = cp & 0xFFFF;
+  for (int n = 1; n < 4 && s[len]; n++) {
+    int l = decodeUtf8(s + len, cp);
+    if (!isCombining(cp))
+      break;
+    code |= (uint64_t)(cp & 0xFFFF) << (16 * n);
+    len += l;
+  }
+  return len;
+}
+
+// ============================================================
+// Rasterize a cluster into a new cell
+// ============================================================
+static int renderCell(const lgfx::IFont *font, uint64_t code,
+                      const char *utf8, int len, uint16_t fg, uint16_t bg) {
+  char buf[16];
+  if (len >= (int)sizeof(buf))
+    return GLYPH_NONE;
+  memcpy(buf, utf8, len);
+  buf[len] = '\0';
+
+  scratch.setFont(font);
+  int w = scratch.textWidth(buf);
+  int h = scratch.fontHeight();
+  if (w <= 0 || w > 255 || h <= 0 || h > 255)
+    return GLYPH_NONE;
+
+  size_t bytes = (size_t)w * h * 2;
+  while (freeList == GLYPH_NONE || usedBytes + bytes > budget) {
+    if (!evictOne())
+      return GLYPH_NONE;
+  }
+  uint16_t *px = (uint16_t *)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+  if (!px)
+    return GLYPH_NONE;
+
+  if (scratch.width() < w || scratch.height() < h) {
+    int sw = scratch.width() > w ? scratch.width() : w;
+    int sh = scratch.height() > h ? scratch.height() : h;
+    scratch.createSprite(sw, sh);
+  }
+  scratch.fillRect(0, 0, w, h, bg);
+  scratch.setTextColor(fg, bg);
+  scratch.setTextDatum(top_left);
+  scratch.drawString(buf, 0, 0);
+  const uint16_t *src = (const uint16_t *)scratch.getBuffer();
+  for (int row = 0; row < h; row++)
+    pixCopy(px + row * w, src + row * scratch.width(), w);
+
+  int id = freeList;
+  GlyphCell &c = cells[id];
+  freeList = c.next;
+  c.font = font;
+  c.code = code;
+  c.fg = fg;
+  c.bg = bg;
+  c.w = w;
+  c.h = h;
+  c.pinned = false;
+  c.pixels = px;
+  int b = bucketOf(font, code, fg, bg);
+  c.next = buckets[b];
+  buckets[b] = id;
+  usedBytes += bytes;
+  return id;
+}
+
+static int lookupCell(const lgfx::IFont *font, uint64_t code,
+                      const char *utf8, int len, uint16_t fg, uint16_t bg) {
+  int id = findCell(font, code, fg, bg);
+  if (id != GLYPH_NONE) {
+    hits++;
+  } else {
+    misses++;
+    id = renderCell(font, code, utf8, len, fg, bg);
+    if (id == GLYPH_NONE)
+      return GLYPH_NONE;
+  }
+  cells[id].lastUse = ++useClock;
+  return id;
+}
+
+// ============================================================
+// Draw
+// ============================================================
+int glyphDrawString(LGFX_Sprite &dst, const char *str, int x, int y,
+                    uint16_t fg, uint16_t bg) {
+  const lgfx::IFont *font = dst.getFont();
+  uint8_t datum = dst.getTextDatum();
+  if (!ready || !font || (datum & 16))
+    return -1; // baseline datums: let LovyanGFX place the text
+  int h = dst.fontHeight();
+  if (h > 255)
+    return -1;
+
+  int w = dst.textWidth(str);
+  int left = x, top = y;
+  if ((datum & 3) == 1)
+    left -= w / 2;
+  else if ((datum & 3) == 2)
+    left -= w;
+  if ((datum & 12) == 4)
+    top -= h / 2;
+  else if ((datum & 12) == 8)
+    top -= h;
+
+  int cx = left;
+  while (*str) {
+    uint64_t code;
+    int len = nextCluster(str, code);
+    int id = lookupCell(font, code, str, len, fg, bg);
+    if (id != GLYPH_NONE) {
+      const GlyphCell &c = cells[id];
+      dst.pushImage(cx, top, c.w, c.h, (const lgfx::swap565_t *)c.pixels);
+      cx += c.w;
+    } else {
+      // Budget exhausted by pinned cells: draw this cluster directly
+      char buf[16];
+      int n = len < 15 ? len : 15;
+      memcpy(buf, str, n);
+      buf[n] = '\0';
+      dst.setTextDatum(top_left);
+      cx += dst.drawString(buf, cx, top);
+      dst.setTextDatum(datum);
+    }
+    str += len;
+  }
+  return cx - left;
+}
+
+void glyphWarm(const lgfx::IFont *font, const char *chars, uint16_t fg,
+               uint16_t bg) {
+  if (!ready)
+    return;
+  while (*chars) {
+    uint64_t code;
+    int len = nextCluster(chars, code);
+    int id = lookupCell(font, code, chars, len, fg, bg);
+    if (id != GLYPH_NONE)
+      cells[id].pinned = true;
+    chars += len;
+  }
+}
+
+uint32_t glyphCacheHits(void) { return hits; }
+uint32_t glyphCacheMisses(void) { return misses; }
+size_t glyphCacheBytes(void) { return usedBytes; }
@@ -0,0 +1,31 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// LRU glyph raster cache
+// Opaque text (fg != bg) is drawn from pre-rendered glyph cells keyed
+// by font, glyph cluster, foreground and background colour, so a
+// redraw becomes a row of blits. A cluster is a base codepoint plus its
+// combining marks (Thai vowels / tone marks stack on the base glyph).
+// Cells live in PSRAM within GLYPH_CACHE_BYTES; warmed cells are pinned.
+// ============================================================
+#define GLYPH_CACHE_SLOTS 384 // cached cells (lookup table = 2x)
+
+void glyphCacheSetup(size_t budgetBytes = GLYPH_CACHE_BYTES);
+
+// Draws `str` with dst's current font and datum. Returns the advance
+// width, or -1 when the string can't be served from the cache (no cache,
+// baseline datum, text too tall) and must go through drawString().
+int glyphDrawString(LGFX_Sprite &dst, const char *str, int x, int y,
+                    uint16_t fg, uint16_t bg);
+
+// Pre-renders and pins every character of `chars` (clock digits etc.)
+void glyphWarm(const lgfx::IFont *font, const char *chars, uint16_t fg,
+               uint16_t bg);
+
+// --- Stats ---
+uint32_t glyphCacheHits(void);
+uint32_t glyphCacheMisses(void);
+size_t glyphCacheBytes(void);
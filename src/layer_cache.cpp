@@ -0,0 +1,60 @@
+#include "layer_cache.h"
+#include <esp_heap_caps.h>
+
+// ============================================================
+// Slots — allocated lazily the first time a screen is stored
+// ============================================================
+struct Layer {
+  uint16_t *pixels;
+  uint32_t variant;
+  bool valid;
+};
+
+static Layer layers[LAYER_SLOTS];
+
+bool layerRestore(int slot, uint32_t variant, void *frame) {
+  if (slot < 0 || slot >= LAYER_SLOTS || !frame)
+    return false;
+  Layer &l = layers[slot];
+  if (!l.valid || l.variant != variant)
+    return false;
+  memcpy(frame, l.pixels, LAYER_BYTES);
+  return true;
+}
+
+void layerStore(int slot, uint32_t variant, const void *frame) {
+  if (slot < 0 || slot >= LAYER_SLOTS || !frame)
+    return;
+  Layer &l = layers[slot];
+  if (!l.pixels) {
+    l.pixels = (uint16_t *)heap_caps_malloc(LAYER_BYTES, MALLOC_CAP_SPIRAM);
+    if (!l.pixels) {
+      Serial.printf("[Layer] No PSRAM for screen %d, rendering uncached\n",
+                    slot);
+      return;
+    }
+  }
+  memcpy(l.pixels, frame, LAYER_BYTES);
+  l.variant = variant;
+  l.valid = true;
+}
+
+void layerInvalidate(int slot) {
+  if (slot >= 0 && slot < LAYER_SLOTS)
+    layers[slot].valid = false;
+}
+
+void layerInvalidateAll(void) {
+  for (int i = 0; i < LAYER_SLOTS; i++)
+    layers[i].valid = false;
+}
+
+uint32_t layerHash(const void *data, size_t len, uint32_t seed) {
+  const uint8_t *p = (const uint8_t *)data;
+  uint32_t h = seed;
+  for (size_t i = 0; i < len; i++) {
+    h ^= p[i];
+    h *= 16777619u;
+  }
+  return h;
+}
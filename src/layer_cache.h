@@ -0,0 +1,23 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Per-screen static layer cache
+// Each screen's chrome (header bar, cards, shadows, static labels and
+// buttons) is rasterized once into a PSRAM copy of the frame. Later
+// visits memcpy it back and only draw the dynamic widgets on top.
+// A layer is keyed by a variant hash so screens whose chrome depends on
+// state (e.g. "Module 3" title) re-render when that state changes.
+// ============================================================
+#define LAYER_SLOTS 16
+#define LAYER_BYTES ((size_t)LCD_WIDTH * LCD_HEIGHT * UI_CANVAS_BPP / 8)
+
+bool layerRestore(int slot, uint32_t variant, void *frame);
+void layerStore(int slot, uint32_t variant, const void *frame);
+void layerInvalidate(int slot);
+void layerInvalidateAll(void); // e.g. after a theme / language change
+
+// FNV-1a, chainable through `seed` to fold several fields into a variant
+uint32_t layerHash(const void *data, size_t len,
+                   uint32_t seed = 2166136261u);
@@ -1,7 +1,15 @@
+#include "asset.h"
 #include "config.h"
+#include "console.h"
 #include "display_module.h"
+#include "pixel_kernels.h"
+#include "power.h"
+#include "profiler.h"
+#include "regimen.h"
 #include "scheduler.h"
 #include "servo_control.h"
+#include "timebase.h"
+#include "touch_input.h"
 #include "ui_manager.h"
 #include "wifi_manager.h"
 #include <Arduino.h>
@@ -12,62 +20,148 @@
 
 
 // ============================================================
+// Dose sequencer — dispenses one module at a time. Advanced from loop()
+// whenever the previous module's servo run and animation have finished,
+// so touch, scheduler and WiFi keep running during a dose.
 // ============================================================
-// Called when user clicks "PRESS TO DISPENSE" on the confirmation screen
-// ============================================================
-void onConfirmedDispense(int timeSlotIndex) {
-  Serial.printf("[Main] User confirmed dispense for slot %d\n", timeSlotIndex);
+static int doseSlot = -1; // time slot being dispensed, -1 = none
+static uint8_t doseModules = 0; // modules in the dose, 0 = idle
+static uint8_t pendingModules = 0; // triggered, awaiting confirmation
+static int pendingSlot = -1;
+static bool confirmDeferred = false; // triggered during a dose
+static uint8_t dosePills[NUM_MODULES];    // per module, from the regimen
+static uint8_t pendingPills[NUM_MODULES];
+static int doseNextModule = 0;
+static int dosePillsLeft = 0; // of doseNextModule - 1
+static int doseDispensed = 0;
+
+static void doseLoop(void) {
+  if (!doseModules) {
+    // A trigger that came in during the dose, once its result is shown
+    if (confirmDeferred && !uiIsAnimating()) {
+      confirmDeferred = false;
+      uiShowConfirmDispense(pendingSlot);
+    }
+    return;
+  }
+  if (servoIsBusy() || uiIsAnimating())
+    return;
 
-  int dispensed = 0;
-  for (int m = 0; m < NUM_MODULES; m++) {
+  // Further pills of the module just dispensed (`pills` / `taper`)
+  if (dosePillsLeft > 0) {
+    int m = doseNextModule - 1;
     MedModule &mod = moduleGet(m);
-    if (mod.slotMask & (1 << timeSlotIndex)) {
-      Serial.printf("[Main] Dispensing module %d (%s)\n", m, mod.name);
-
-      // Show dispensing animation
-      uiShowDispensing(m);
-
-      // Activate servo
-      servoDispense(m);
-
-      // Decrement qty
-      if (mod.qty > 0) {
-        mod.qty--;
-      }
+    dosePillsLeft--;
+    uiShowDispensing(m);
+    servoDispense(m);
+    if (mod.qty > 0) {
+      mod.qty--;
+    }
+    return;
+  }
 
-      dispensed++;
+  while (doseNextModule < NUM_MODULES) {
+    int m = doseNextModule++;
+    MedModule &mod = moduleGet(m);
+    if (!(doseModules & (1 << m)))
+      continue;
+
+    int pills = dosePills[m] ? dosePills[m] : 1;
+    Serial.printf("[Main] Dispensing module %d (%s), %d pill%s\n", m,
+                  mod.name, pills, pills > 1 ? "s" : "");
+    dosePillsLeft = pills - 1;
+    rxRecord(m, timeEpoch()); // gap / max count from here
+
+    // Show dispensing animation + activate servo
+    uiShowDispensing(m);
+    servoDispense(m);
+
+    // Decrement qty
+    if (mod.qty > 0) {
+      mod.qty--;
     }
+    doseDispensed++;
+    return;
   }
 
   // Save updated quantities
-  if (dispensed > 0) {
+  if (doseDispensed > 0) {
     schedulerSave();
-    uiShowResult(timeSlotIndex, true);
+    uiShowResult(doseSlot, true);
   } else {
     Serial.println("[Main] No modules assigned to this slot");
   }
+  doseSlot = -1;
+  doseModules = 0;
 }
 
 // ============================================================
-// Dispense callback — triggered by scheduler when a time slot fires
+// Called when user clicks "PRESS TO DISPENSE" on the confirmation screen
 // ============================================================
-void onDispenseTrigger(int timeSlotIndex) {
-  Serial.printf("[Main] Time slot %d triggered\n", timeSlotIndex);
-
-  // Check if any modules are actually assigned to this slot
-  int assignedCount = 0;
+void onConfirmedDispense(int timeSlotIndex) {
+  Serial.printf("[Main] User confirmed dispense for slot %d\n", timeSlotIndex);
+  if (doseModules) {
+    Serial.println("[Main] Dose already in progress");
+    return;
+  }
+  // Regimen gap / max, checked again now: the screen may have waited
+  uint32_t now = timeEpoch();
   for (int m = 0; m < NUM_MODULES; m++) {
-    MedModule &mod = moduleGet(m);
-    if (mod.slotMask & (1 << timeSlotIndex)) {
-      assignedCount++;
+    if (!(pendingModules & (1 << m)) || !rxActive(m))
+      continue;
+    uint32_t wait = rxWait(m, now);
+    if (wait) {
+      Serial.printf("[Main] Module %d locked out for %lu min\n", m,
+                    (unsigned long)((wait + 59) / 60));
+      pendingModules &= ~(1 << m);
     }
   }
+  if (!pendingModules) {
+    uiShowResult(timeSlotIndex, false);
+    return;
+  }
+  doseSlot = timeSlotIndex;
+  doseModules = pendingModules;
+  memcpy(dosePills, pendingPills, sizeof(dosePills));
+  pendingModules = 0;
+  doseNextModule = 0;
+  dosePillsLeft = 0;
+  doseDispensed = 0;
+}
 
-  if (assignedCount > 0) {
+// ============================================================
+// Dispense callback — triggered by scheduler when a time slot fires
+// The scheduler counts a dose as done once it is raised, so a trigger
+// is never dropped: while a dose runs or a confirmation is on screen
+// its modules join the pending ones (the larger pill count wins), and
+// a confirmation deferred by a dose is shown when the dose is over.
+// ============================================================
+void onDispenseTrigger(int timeSlotIndex, uint8_t modules) {
+  Serial.printf("[Main] Time slot %d triggered (modules 0x%02X)\n",
+                timeSlotIndex, modules);
+
+  if (!modules) {
+    Serial.println("[Main] No modules assigned to this slot (ignored)");
+    return;
+  }
+  bool busy = doseModules != 0;
+  bool merge = busy || confirmDeferred || uiConfirmPending();
+  if (!merge) {
+    pendingModules = 0;
+    memset(pendingPills, 0, sizeof(pendingPills));
+    pendingSlot = timeSlotIndex;
+  }
+  pendingModules |= modules;
+  for (int m = 0; m < NUM_MODULES; m++) {
+    uint8_t n = schedulerDosePills(m);
+    pendingPills[m] = n > pendingPills[m] ? n : pendingPills[m];
+  }
+  if (busy) {
+    Serial.println("[Main] Dose in progress, confirmation deferred");
+    confirmDeferred = true;
+  } else if (!merge) {
     // Wait for user confirmation instead of dispensing immediately
     uiShowConfirmDispense(timeSlotIndex);
-  } else {
-    Serial.println("[Main] No modules assigned to this slot (ignored)");
   }
 }
 
@@ -101,8 +195,14 @@ void setup() {
   pinMode(LED_PIN, OUTPUT);
   digitalWrite(LED_PIN, LOW);
 
-  // Display
+  // Serial debug commands ("help")
+  profSetup();
+  pixKernelsSetup();
+  assetSetup();
+
+  // Display + touch interrupt
   displaySetup();
+  touchSetup();
 
   // Servo
   servoSetup();
@@ -110,7 +210,11 @@ void setup() {
   // WiFi
   wifiSetup();
 
-  // Scheduler (RTC + NVS)
+  // Clock: DS3231 read once, then extrapolated
+  timebaseSetup();
+
+  // Regimens, then the scheduler that queues them (NVS)
+  rxSetup();
   schedulerSetup();
   schedulerSetCallback(onDispenseTrigger);
 
@@ -119,13 +223,27 @@ void setup() {
   uiSetManualDispenseCallback(onManualDispense);
   uiSetConfirmDispenseCallback(onConfirmedDispense);
 
+  // Idle governor (after the UI: it repaints on wake)
+  powerSetup();
+
   Serial.println("=== Setup Complete ===");
 }
 
 // ============================================================
 void loop() {
+  uint32_t loopStamp = profStamp();
+  touchLoop();
+  uint32_t uiStamp = profStamp();
   uiLoop();
+  profEnd(PROF_UI, uiStamp);
+  displayLoop();
+  servoLoop();
+  doseLoop();
+  timebaseLoop();
   schedulerLoop();
   wifiLoop();
-  delay(10);
+  consoleLoop();
+  profLoop();
+  profEnd(PROF_LOOP, loopStamp);
+  powerLoop();
 }
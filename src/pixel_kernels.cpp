@@ -0,0 +1,261 @@
+#include "pixel_kernels.h"
+#include "console.h"
+#include "profiler.h"
+
+// RGB565 spread to 0b00000gggggg00000rrrrr000000bbbbb: each channel
+// gets headroom so one multiply blends all three
+#define SPREAD_MASK 0x07E0F81Fu
+
+static inline uint32_t alpha5(uint32_t a8) { return (a8 + 4) >> 3; } // 0..32
+
+// ============================================================
+// Scalar references
+// ============================================================
+static inline uint16_t blend1(uint16_t d, uint16_t fg565, uint32_t a5) {
+  uint32_t fg = (fg565 | (uint32_t)fg565 << 16) & SPREAD_MASK;
+  uint16_t d565 = pixSwap(d);
+  uint32_t bg = (d565 | (uint32_t)d565 << 16) & SPREAD_MASK;
+  uint32_t r = ((((fg - bg) * a5) >> 5) + bg) & SPREAD_MASK;
+  return pixSwap((uint16_t)(r | r >> 16));
+}
+
+void pixFillRef(uint16_t *dst, uint16_t color, int n) {
+  uint16_t c = pixSwap(color);
+  for (int i = 0; i < n; i++)
+    dst[i] = c;
+}
+
+void pixCopyRef(uint16_t *dst, const uint16_t *src, int n) {
+  for (int i = 0; i < n; i++)
+    dst[i] = src[i];
+}
+
+void pixCopySwapRef(uint16_t *dst, const uint16_t *src, int n) {
+  for (int i = 0; i < n; i++)
+    dst[i] = pixSwap(src[i]);
+}
+
+void pixBlendRef(uint16_t *dst, const uint16_t *src, uint8_t alpha, int n) {
+  uint32_t a5 = alpha5(alpha);
+  for (int i = 0; i < n; i++)
+    dst[i] = blend1(dst[i], pixSwap(src[i]), a5);
+}
+
+void pixBlendColorRef(uint16_t *dst, uint16_t color, const uint8_t *cover,
+                      int n) {
+  for (int i = 0; i < n; i++)
+    dst[i] = blend1(dst[i], color, alpha5(cover[i]));
+}
+
+// ============================================================
+// Vector versions — same arithmetic, 8 (copy/fill) or 4 (blend) lanes.
+// Loads and stores go through memcpy so spans need no alignment. On the
+// P4 the lanes are unrolled into scalar code (see pixel_kernels.h).
+// ============================================================
+#if PIXEL_KERNELS_VECTOR
+typedef uint16_t v8u16 __attribute__((vector_size(16)));
+typedef uint16_t v4u16 __attribute__((vector_size(8)));
+typedef uint32_t v4u32 __attribute__((vector_size(16)));
+typedef uint8_t v4u8 __attribute__((vector_size(4)));
+
+static inline v4u32 load4(const uint16_t *p) {
+  v4u16 t;
+  memcpy(&t, p, sizeof(t));
+  return __builtin_convertvector(t, v4u32);
+}
+
+static inline void store4(uint16_t *p, v4u32 v) {
+  v4u16 t = __builtin_convertvector(v, v4u16);
+  memcpy(p, &t, sizeof(t));
+}
+
+static inline v4u32 swap4(v4u32 c) { return ((c << 8) | (c >> 8)) & 0xFFFF; }
+
+static inline v4u32 spread4(v4u32 c) { return (c | c << 16) & SPREAD_MASK; }
+
+// d in buffer order, fg spread, a5 per lane
+static inline v4u32 blend4(v4u32 d, v4u32 fg, v4u32 a5) {
+  v4u32 bg = spread4(swap4(d));
+  v4u32 r = ((((fg - bg) * a5) >> 5) + bg) & SPREAD_MASK;
+  return swap4((r | r >> 16) & 0xFFFF);
+}
+
+void pixFill(uint16_t *dst, uint16_t color, int n) {
+  uint16_t c = pixSwap(color);
+  v8u16 v;
+  for (int k = 0; k < 8; k++)
+    v[k] = c;
+  int i = 0;
+  for (; i + 8 <= n; i += 8)
+    memcpy(dst + i, &v, sizeof(v));
+  for (; i < n; i++)
+    dst[i] = c;
+}
+
+void pixCopy(uint16_t *dst, const uint16_t *src, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    v8u16 v;
+    memcpy(&v, src + i, sizeof(v));
+    memcpy(dst + i, &v, sizeof(v));
+  }
+  for (; i < n; i++)
+    dst[i] = src[i];
+}
+
+void pixCopySwap(uint16_t *dst, const uint16_t *src, int n) {
+  int i = 0;
+  for (; i + 8 <= n; i += 8) {
+    v8u16 v;
+    memcpy(&v, src + i, sizeof(v));
+    v = (v << 8) | (v >> 8);
+    memcpy(dst + i, &v, sizeof(v));
+  }
+  for (; i < n; i++)
+    dst[i] = pixSwap(src[i]);
+}
+
+void pixBlend(uint16_t *dst, const uint16_t *src, uint8_t alpha, int n) {
+  uint32_t a = alpha5(alpha);
+  v4u32 a5 = {a, a, a, a};
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    v4u32 fg = spread4(swap4(load4(src + i)));
+    store4(dst + i, blend4(load4(dst + i), fg, a5));
+  }
+  for (; i < n; i++)
+    dst[i] = blend1(dst[i], pixSwap(src[i]), a);
+}
+
+void pixBlendColor(uint16_t *dst, uint16_t color, const uint8_t *cover,
+                   int n) {
+  uint32_t c = (color | (uint32_t)color << 16) & SPREAD_MASK;
+  v4u32 fg = {c, c, c, c};
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    v4u8 m;
+    memcpy(&m, cover + i, sizeof(m));
+    v4u32 a5 = (__builtin_convertvector(m, v4u32) + 4) >> 3;
+    store4(dst + i, blend4(load4(dst + i), fg, a5));
+  }
+  for (; i < n; i++)
+    dst[i] = blend1(dst[i], color, alpha5(cover[i]));
+}
+#else
+void pixFill(uint16_t *dst, uint16_t color, int n) {
+  pixFillRef(dst, color, n);
+}
+void pixCopy(uint16_t *dst, const uint16_t *src, int n) {
+  pixCopyRef(dst, src, n);
+}
+void pixCopySwap(uint16_t *dst, const uint16_t *src, int n) {
+  pixCopySwapRef(dst, src, n);
+}
+void pixBlend(uint16_t *dst, const uint16_t *src, uint8_t alpha, int n) {
+  pixBlendRef(dst, src, alpha, n);
+}
+void pixBlendColor(uint16_t *dst, uint16_t color, const uint8_t *cover,
+                   int n) {
+  pixBlendColorRef(dst, color, cover, n);
+}
+#endif
+
+// ============================================================
+// `kern [n]` — bit-exactness and throughput, reference vs vector
+// ============================================================
+#define KERN_MAX_PX 16384
+
+enum { K_FILL, K_COPY, K_COPY_SWAP, K_BLEND, K_BLEND_COLOR, K_COUNT };
+static const char *const kernNames[K_COUNT] = {"fill", "copy", "copySwap",
+                                               "blend", "blendColor"};
+
+static uint16_t *kSrc;
+static uint8_t *kCover;
+
+static void runKernel(int k, bool vec, uint16_t *dst, int n) {
+  switch (k) {
+  case K_FILL:
+    (vec ? pixFill : pixFillRef)(dst, 0x2652, n);
+    break;
+  case K_COPY:
+    (vec ? pixCopy : pixCopyRef)(dst, kSrc, n);
+    break;
+  case K_COPY_SWAP:
+    (vec ? pixCopySwap : pixCopySwapRef)(dst, kSrc, n);
+    break;
+  case K_BLEND:
+    (vec ? pixBlend : pixBlendRef)(dst, kSrc, 100, n);
+    break;
+  case K_BLEND_COLOR:
+    (vec ? pixBlendColor : pixBlendColorRef)(dst, 0xFA8A, kCover, n);
+    break;
+  }
+}
+
+static uint32_t xorshift(uint32_t &s) {
+  s ^= s << 13;
+  s ^= s >> 17;
+  s ^= s << 5;
+  return s;
+}
+
+static void seedBuffers(uint16_t *dst, int n) {
+  uint32_t s = 0x9E3779B9u;
+  for (int i = 0; i < n; i++) {
+    kSrc[i] = (uint16_t)xorshift(s);
+    dst[i] = (uint16_t)xorshift(s);
+    kCover[i] = (uint8_t)xorshift(s);
+  }
+  kCover[0] = 0; // both ends of the coverage range
+  kCover[n - 1] = 255;
+}
+
+static void kernCommand(const char *args) {
+  int n = atoi(args);
+  if (n <= 0)
+    n = LCD_WIDTH * 10;
+  if (n > KERN_MAX_PX)
+    n = KERN_MAX_PX;
+  kSrc = (uint16_t *)malloc(n * sizeof(uint16_t));
+  kCover = (uint8_t *)malloc(n);
+  uint16_t *ref = (uint16_t *)malloc(n * sizeof(uint16_t));
+  uint16_t *vec = (uint16_t *)malloc(n * sizeof(uint16_t));
+  if (!kSrc || !kCover || !ref || !vec) {
+    Serial.println("[Kern] Out of memory");
+  } else {
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    int reps = 1000000 / n + 1;
+    Serial.printf("[Kern] %d px per call, %d calls%s\n", n, reps,
+                  PIXEL_KERNELS_VECTOR ? " (vec: unrolled scalar on RV32)"
+                                       : " (vector path disabled)");
+    for (int k = 0; k < K_COUNT; k++) {
+      // Exactness: both versions from the same inputs
+      seedBuffers(ref, n);
+      runKernel(k, false, ref, n);
+      seedBuffers(vec, n);
+      runKernel(k, true, vec, n);
+      bool exact = memcmp(ref, vec, n * sizeof(uint16_t)) == 0;
+
+      float mpix[2];
+      for (int v = 0; v < 2; v++) {
+        uint32_t t = profStamp();
+        for (int r = 0; r < reps; r++)
+          runKernel(k, v, v ? vec : ref, n);
+        uint32_t us = (profStamp() - t) / mhz;
+        mpix[v] = us ? (float)n * reps / us : 0;
+      }
+      Serial.printf("  %-10s ref %7.1f  vec %7.1f MPix/s  %s\n",
+                    kernNames[k], mpix[0], mpix[1],
+                    exact ? "exact" : "MISMATCH");
+    }
+  }
+  free(kSrc);
+  free(kCover);
+  free(ref);
+  free(vec);
+}
+
+void pixKernelsSetup(void) {
+  consoleRegister("kern", kernCommand,
+                  "[n] pixel kernels: reference vs vector, MPix/s");
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// RGB565 pixel kernels
+// Span primitives on raw 16-bit pixel buffers in sprite / panel byte
+// order (byte-swapped RGB565, what LovyanGFX sprites and the DMA strips
+// hold). Colours are passed as plain RGB565 values like COL_*.
+// Each kernel has a scalar reference (pix*Ref) and a version written
+// with GCC vector extensions. On a host build those become SSE / NEON.
+// RV32 GCC has no SIMD lowering for them, so on the P4 they compile to
+// per-lane scalar code: these are scalar kernels on the device.
+// Not in scope: a PIE (the P4's vector unit) path. It would be
+// hand-written assembly, and nothing here can assemble it or check it
+// bit for bit against the reference without the board.
+// `kern` on the console checks the two versions bit for bit and
+// reports MPix/s for each; the host tests (test/test_pixel_kernels)
+// check them over every span length.
+// ============================================================
+#define PIXEL_KERNELS_VECTOR 1 // 0 = route every call to the reference
+
+inline uint16_t pixSwap(uint16_t c) { return (uint16_t)(c << 8 | c >> 8); }
+
+// --- Kernels ---
+void pixFill(uint16_t *dst, uint16_t color, int n);
+void pixCopy(uint16_t *dst, const uint16_t *src, int n);
+// Byte-swapping copy: native-order RGB565 <-> buffer order
+void pixCopySwap(uint16_t *dst, const uint16_t *src, int n);
+// dst = src over dst at alpha / 255 (quantized to 32 steps)
+void pixBlend(uint16_t *dst, const uint16_t *src, uint8_t alpha, int n);
+// dst = color over dst at cover[i] / 255, e.g. anti-aliased edges
+void pixBlendColor(uint16_t *dst, uint16_t color, const uint8_t *cover,
+                   int n);
+
+// --- Scalar references ---
+void pixFillRef(uint16_t *dst, uint16_t color, int n);
+void pixCopyRef(uint16_t *dst, const uint16_t *src, int n);
+void pixCopySwapRef(uint16_t *dst, const uint16_t *src, int n);
+void pixBlendRef(uint16_t *dst, const uint16_t *src, uint8_t alpha, int n);
+void pixBlendColorRef(uint16_t *dst, uint16_t color, const uint8_t *cover,
+                      int n);
+
+void pixKernelsSetup(void); // registers the `kern` console command
@@ -0,0 +1,159 @@
+#include "power.h"
+#include "console.h"
+#include "display_module.h"
+#include "scheduler.h"
+#include "servo_control.h"
+#include "timebase.h"
+#include "ui_manager.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+
+static PowerState state = POWER_ACTIVE;
+static unsigned long lastActivityMs = 0;
+static int64_t wokeAtUs = 0;       // light sleep ended on a touch INT
+static bool swallowTouch = false;  // wake touch, dropped until release
+
+// Stats for `power`
+static uint32_t lightSleeps = 0;
+static uint64_t sleptUs = 0;
+static uint32_t wakeCount = 0, wakeLastUs = 0, wakeMaxUs = 0;
+
+static const char *const stateNames[] = {"active", "idle", "sleep"};
+
+// ============================================================
+// State changes
+// ============================================================
+static void enter(PowerState s) {
+  if (s == state)
+    return;
+  if (s == POWER_SLEEP) {
+    displayWait();
+    getDisplay().sleep();
+  }
+  Serial.printf("[Power] %s -> %s\n", stateNames[state], stateNames[s]);
+  state = s;
+}
+
+// Back to ACTIVE; `since` is the wake event (esp_timer us)
+static void wake(int64_t since, const char *why) {
+  if (state == POWER_ACTIVE)
+    return;
+  bool panelOff = state == POWER_SLEEP;
+  if (panelOff)
+    getDisplay().wakeup();
+  enter(POWER_ACTIVE);
+  uiRepaint(); // seconds back on the clock; full frame, on the panel
+
+  uint32_t us = (uint32_t)(esp_timer_get_time() - since);
+  wakeCount++;
+  wakeLastUs = us;
+  wakeMaxUs = us > wakeMaxUs ? us : wakeMaxUs;
+  Serial.printf("[Power] Wake (%s%s) -> first full frame in %lu us\n", why,
+                panelOff ? ", panel" : "", (unsigned long)us);
+}
+
+// ============================================================
+// Light sleep until the next minute boundary, dose or touch
+// ============================================================
+static void idleWait(void) {
+#if POWER_LIGHT_SLEEP
+  uint32_t e = timeEpoch();
+  int64_t wakeAt = timeEpochUs(e - e % 60 + 60) + POWER_MINUTE_MARGIN_US;
+  int64_t fire = schedulerNextFireUs();
+  if (fire >= 0 && fire < wakeAt)
+    wakeAt = fire; // the dose timer fires as the CPU wakes
+  int64_t sync = timebaseWakeUs();
+  if (sync >= 0 && sync < wakeAt)
+    wakeAt = sync; // an RTC edge to catch
+  int64_t left = wakeAt - esp_timer_get_time();
+  uint64_t us = left > 0 ? left : 1;
+
+  displayWait(); // strips must be off the bus
+  Serial.flush();
+  touchWakeArm();
+  esp_sleep_enable_timer_wakeup(us);
+  int64_t t = esp_timer_get_time();
+  esp_light_sleep_start();
+  int64_t now = esp_timer_get_time();
+  bool byTouch = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO;
+  touchWakeDisarm(byTouch);
+
+  lightSleeps++;
+  sleptUs += now - t;
+  wokeAtUs = byTouch ? now : 0;
+#else
+  delay(POWER_IDLE_DELAY_MS);
+#endif
+}
+
+// ============================================================
+// Public API
+// ============================================================
+void powerLoop(void) {
+  unsigned long now = millis();
+  // Attention needed (dose confirmation, animation, finger down)
+  if (!uiCanIdle() || servoIsBusy() || touchIsDown()) {
+    lastActivityMs = now;
+    wake(esp_timer_get_time(), "ui");
+  }
+
+  unsigned long idleMs = now - lastActivityMs;
+  if (state == POWER_ACTIVE && idleMs >= POWER_IDLE_MS)
+    enter(POWER_IDLE);
+  else if (state == POWER_IDLE && idleMs >= POWER_SLEEP_MS)
+    enter(POWER_SLEEP);
+
+  if (state == POWER_ACTIVE)
+    delay(POWER_ACTIVE_DELAY_MS);
+  else
+    idleWait();
+}
+
+PowerState powerState(void) { return state; }
+
+bool powerTouch(const TouchEvent &ev) {
+  lastActivityMs = millis();
+  if (ev.phase == TOUCH_PRESS && state != POWER_ACTIVE) {
+    // The user couldn't see what they touched on a sleeping panel
+    swallowTouch = state == POWER_SLEEP;
+    wake(wokeAtUs ? wokeAtUs : (int64_t)ev.timeMs * 1000, "touch");
+  }
+  wokeAtUs = 0;
+  if (!swallowTouch)
+    return false;
+  if (ev.phase == TOUCH_RELEASE)
+    swallowTouch = false;
+  return true;
+}
+
+// ============================================================
+// `power` — state, time slept and wake latency
+// ============================================================
+static void powerCommand(const char *args) {
+  if (strcmp(args, "idle") == 0 || strcmp(args, "sleep") == 0) {
+    // Pretend the last touch was long enough ago
+    unsigned long ago = args[0] == 'i' ? POWER_IDLE_MS : POWER_SLEEP_MS;
+    lastActivityMs = millis() - ago;
+    if (args[0] == 's')
+      enter(POWER_IDLE);
+    return;
+  }
+  if (*args) {
+    Serial.println("usage: power [idle|sleep]");
+    return;
+  }
+  Serial.printf("[Power] %s, last touch %lu s ago\n", stateNames[state],
+                (millis() - lastActivityMs) / 1000);
+  Serial.printf("  light sleeps %lu, %llu s asleep\n",
+                (unsigned long)lightSleeps,
+                (unsigned long long)(sleptUs / 1000000));
+  Serial.printf("  wakes %lu, to first full frame: last %lu us, max %lu us\n",
+                (unsigned long)wakeCount, (unsigned long)wakeLastUs,
+                (unsigned long)wakeMaxUs);
+}
+
+void powerSetup(void) {
+  lastActivityMs = millis();
+  consoleRegister("power", powerCommand,
+                  "[idle|sleep] governor state, sleep time, wake latency");
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include "config.h"
+#include "touch_input.h"
+#include <Arduino.h>
+
+// ============================================================
+// Idle governor
+// ACTIVE: loop() runs every POWER_ACTIVE_DELAY_MS and the clock ticks
+// every second. After POWER_IDLE_MS without a touch, IDLE: the clock
+// drops to HH:MM, redrawn once a minute, and between minutes the CPU
+// light-sleeps until the next minute boundary, the next dose (the
+// scheduler's timer) or a touch INT. After POWER_SLEEP_MS the ST7796
+// also goes into sleep-in.
+// A touch (or a screen that needs attention, e.g. a dose confirmation)
+// returns to ACTIVE; waking the panel repaints a full frame, and the
+// time from the wake event to that frame being on the panel is logged.
+// ============================================================
+enum PowerState : uint8_t { POWER_ACTIVE, POWER_IDLE, POWER_SLEEP };
+
+void powerSetup(void); // registers the `power` console command
+void powerLoop(void);  // end of loop(): paces it, sleeps when idle
+PowerState powerState(void);
+
+// Every touch event goes through here first. Returns true when the
+// event belongs to a touch that woke the panel and must not act.
+bool powerTouch(const TouchEvent &ev);
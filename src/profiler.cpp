@@ -0,0 +1,144 @@
+#include "profiler.h"
+#include "console.h"
+
+// ============================================================
+// Histogram storage
+// ============================================================
+struct ProfWindow {
+  uint16_t counts[PROF_BUCKETS];
+  uint32_t max;
+};
+
+static ProfWindow windows[PROF_CHANNELS][PROF_WINDOWS];
+static const char *names[PROF_CHANNELS] = {
+    "loop", "uiLoop", "present", "push", "push bytes", "push KB/s"};
+static int curWindow = 0;
+static unsigned long windowStartMs = 0;
+static uint32_t cyclesPerUs = 360;
+
+// Bucket for v: exact below 4, then 4 sub-buckets per power of two
+static int bucketOf(uint32_t v) {
+  if (v < 4)
+    return v;
+  int e = 31 - __builtin_clz(v);
+  int idx = 4 * (e - 1) + ((v >> (e - 2)) & 3);
+  return idx < PROF_BUCKETS ? idx : PROF_BUCKETS - 1;
+}
+
+// Largest value that falls in bucket idx
+static uint32_t bucketTop(int idx) {
+  if (idx < 4)
+    return idx;
+  int e = idx / 4 + 1;
+  uint32_t lo = (uint32_t)(4 + idx % 4) << (e - 2);
+  return lo + (1u << (e - 2)) - 1;
+}
+
+void profRecord(ProfChannel ch, uint32_t value) {
+  if (ch >= PROF_CHANNELS)
+    return;
+  ProfWindow &w = windows[ch][curWindow];
+  uint16_t &c = w.counts[bucketOf(value)];
+  if (c < 0xFFFF)
+    c++;
+  if (value > w.max)
+    w.max = value;
+}
+
+uint32_t profEnd(ProfChannel ch, uint32_t stamp) {
+  uint32_t us = (profStamp() - stamp) / cyclesPerUs;
+  profRecord(ch, us);
+  return us;
+}
+
+void profName(ProfChannel ch, const char *name) {
+  if (ch < PROF_CHANNELS)
+    names[ch] = name;
+}
+
+// ============================================================
+// Reporting
+// ============================================================
+static uint32_t percentile(const uint32_t *merged, uint32_t total,
+                           uint32_t max, int pct) {
+  uint32_t target = (total * pct + 99) / 100;
+  uint32_t seen = 0;
+  for (int i = 0; i < PROF_BUCKETS; i++) {
+    seen += merged[i];
+    if (seen >= target) {
+      uint32_t top = bucketTop(i);
+      return top < max ? top : max;
+    }
+  }
+  return max;
+}
+
+void profReport(void) {
+  Serial.printf("[Prof] last %d s, %u cycles/us\n",
+                PROF_WINDOWS * PROF_WINDOW_MS / 1000, (unsigned)cyclesPerUs);
+  Serial.printf("  %-14s %7s %9s %9s %9s\n", "channel", "n", "p50", "p99",
+                "max");
+  for (int ch = 0; ch < PROF_CHANNELS; ch++) {
+    uint32_t merged[PROF_BUCKETS] = {0};
+    uint32_t total = 0, max = 0;
+    for (int w = 0; w < PROF_WINDOWS; w++) {
+      const ProfWindow &win = windows[ch][w];
+      for (int i = 0; i < PROF_BUCKETS; i++) {
+        merged[i] += win.counts[i];
+        total += win.counts[i];
+      }
+      if (win.max > max)
+        max = win.max;
+    }
+    if (total == 0)
+      continue;
+
+    char label[16];
+    if (names[ch])
+      snprintf(label, sizeof(label), "%s", names[ch]);
+    else
+      snprintf(label, sizeof(label), "draw #%d", ch - PROF_DRAW_BASE);
+    const char *unit = ch == PROF_PUSH_BYTES  ? "B"
+                       : ch == PROF_PUSH_RATE ? "KB"
+                                              : "us";
+    Serial.printf("  %-14s %7u %7u%-2s %7u%-2s %7u%-2s\n", label,
+                  (unsigned)total,
+                  (unsigned)percentile(merged, total, max, 50), unit,
+                  (unsigned)percentile(merged, total, max, 99), unit,
+                  (unsigned)max, unit);
+  }
+}
+
+void profReset(void) {
+  memset(windows, 0, sizeof(windows));
+  curWindow = 0;
+  windowStartMs = millis();
+}
+
+// ============================================================
+void profSetup(void) {
+  cyclesPerUs = ESP.getCpuFreqMHz();
+  if (cyclesPerUs == 0)
+    cyclesPerUs = 1;
+  profReset();
+  consoleRegister(
+      "prof",
+      [](const char *args) {
+        if (strcmp(args, "reset") == 0) {
+          profReset();
+          Serial.println("[Prof] Cleared");
+        } else {
+          profReport();
+        }
+      },
+      "frame/loop timing p50/p99/max ('prof reset' clears)");
+}
+
+void profLoop(void) {
+  if (millis() - windowStartMs < PROF_WINDOW_MS)
+    return;
+  windowStartMs = millis();
+  curWindow = (curWindow + 1) % PROF_WINDOWS;
+  for (int ch = 0; ch < PROF_CHANNELS; ch++)
+    memset(&windows[ch][curWindow], 0, sizeof(ProfWindow));
+}
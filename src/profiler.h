@@ -0,0 +1,38 @@
+#pragma once
+#include <Arduino.h>
+
+// ============================================================
+// Hot-path profiler
+// Durations are taken from the CPU cycle counter (one register read per
+// stamp) and binned into log-linear histograms. Each channel keeps a
+// ring of PROF_WINDOWS histograms, PROF_WINDOW_MS each, so reports
+// cover roughly the last minute. "prof" on the serial console prints
+// p50 / p99 / max per channel, "prof reset" clears them.
+// ============================================================
+#define PROF_BUCKETS 72 // 4 per power of two, exact below 4
+#define PROF_WINDOWS 6
+#define PROF_WINDOW_MS 10000
+#define PROF_MAX_SCREENS 16
+
+enum ProfChannel : uint8_t {
+  PROF_LOOP,       // one loop() iteration, excluding the idle delay
+  PROF_UI,         // uiLoop()
+  PROF_PRESENT,    // CPU time in displayPresent() (fence wait + copy)
+  PROF_PUSH,       // frame on the bus: first DMA region to endWrite
+  PROF_PUSH_BYTES, // bytes per presented frame
+  PROF_PUSH_RATE,  // KB pushed per second, seconds with traffic only
+  PROF_DRAW_BASE   // + screen: renderScreen() per screen
+};
+#define PROF_DRAW(screen) ((ProfChannel)(PROF_DRAW_BASE + (screen)))
+#define PROF_CHANNELS (PROF_DRAW_BASE + PROF_MAX_SCREENS)
+
+void profSetup(void); // registers the console command
+void profLoop(void);  // rotates histogram windows
+
+inline uint32_t profStamp(void) { return ESP.getCycleCount(); }
+uint32_t profEnd(ProfChannel ch, uint32_t stamp); // records, returns us
+void profRecord(ProfChannel ch, uint32_t value);  // raw value (bytes)
+void profName(ProfChannel ch, const char *name);  // label for reports
+
+void profReport(void);
+void profReset(void);
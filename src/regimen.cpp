@@ -0,0 +1,587 @@
+#include "regimen.h"
+#include "console.h"
+#include "profiler.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include <Preferences.h>
+#include <initializer_list>
+
+// ============================================================
+// Bytecode — one opcode byte, then its operands; 16-bit values are
+// little-endian. AT entries come last, sorted by time.
+// ============================================================
+enum RxOp : uint8_t {
+  RX_END,
+  RX_EVERY, // days
+  RX_COURSE, // days (16)
+  RX_PILLS, // n
+  RX_TAPER, // step days, n, n pill counts
+  RX_PRN,
+  RX_GAP,   // minutes (16)
+  RX_MAX,   // n, window minutes (16)
+  RX_AT     // hour, minute
+};
+
+// A decoded program
+struct RxPlan {
+  uint8_t every, pills, taperStep, taperN, maxN, nAt;
+  bool prn;
+  uint16_t course, gapMin, windowMin;
+  const uint8_t *taper;
+  uint16_t at[RX_MAX_AT]; // minute of day
+};
+
+static uint16_t u16(const uint8_t *p) { return p[0] | p[1] << 8; }
+
+static void decode(const RxCode &code, RxPlan &p) {
+  memset(&p, 0, sizeof(p));
+  p.every = 1;
+  p.pills = 1;
+  const uint8_t *c = code.op, *end = code.op + code.len;
+  while (c < end) {
+    switch (*c++) {
+    case RX_EVERY:
+      p.every = *c++;
+      break;
+    case RX_COURSE:
+      p.course = u16(c);
+      c += 2;
+      break;
+    case RX_PILLS:
+      p.pills = *c++;
+      break;
+    case RX_TAPER:
+      p.taperStep = c[0];
+      p.taperN = c[1];
+      p.taper = c + 2;
+      c += 2 + p.taperN;
+      break;
+    case RX_PRN:
+      p.prn = true;
+      break;
+    case RX_GAP:
+      p.gapMin = u16(c);
+      c += 2;
+      break;
+    case RX_MAX:
+      p.maxN = c[0];
+      p.windowMin = u16(c + 1);
+      c += 3;
+      break;
+    case RX_AT:
+      p.at[p.nAt++] = c[0] * 60 + c[1];
+      c += 2;
+      break;
+    default: // RX_END
+      return;
+    }
+  }
+}
+
+// Pills per dose on `day` (from day 0), 0 when it is not a dosing day
+static int pillsOn(const RxPlan &p, int32_t day) {
+  if (day < 0 || day % p.every)
+    return 0;
+  if (p.course && day >= p.course)
+    return 0;
+  if (p.taperN) {
+    int step = day / p.taperStep;
+    return step < p.taperN ? p.taper[step] : 0;
+  }
+  return p.pills;
+}
+
+// ============================================================
+// Compiler
+// ============================================================
+// Number followed by an optional unit: d(ays), h(ours), m(inutes).
+// Returns minutes (days for `d` when `days` is set), -1 on error.
+static long parseSpan(const char *&s, bool days) {
+  char *e;
+  long v = strtol(s, &e, 10);
+  if (e == s || v <= 0)
+    return -1;
+  s = e;
+  char u = *s;
+  if (u == 'd' || u == 'h' || u == 'm')
+    s++;
+  if (days)
+    return u == 'd' ? v : -1;
+  return u == 'd' ? v * 1440 : u == 'h' ? v * 60 : u == 'm' ? v : -1;
+}
+
+static bool emit(RxCode &code, std::initializer_list<int> bytes) {
+  if (code.len + bytes.size() > RX_CODE_MAX)
+    return false;
+  for (int b : bytes)
+    code.op[code.len++] = (uint8_t)b;
+  return true;
+}
+
+bool rxCompile(const char *src, RxCode &code, char *err, int errLen) {
+  code.len = 0;
+  uint16_t at[RX_MAX_AT];
+  int nAt = 0;
+  bool prn = false, taper = false, pills = false, ok = true;
+  const char *fail = nullptr;
+  int failAt = -1; // character offset into src, -1 = the whole of it
+
+  // Cut short, the saved text would no longer be what was compiled
+  if (strlen(src) >= RX_SRC_MAX) {
+    snprintf(err, errLen, "longer than %d characters", RX_SRC_MAX - 1);
+    return false;
+  }
+  char buf[RX_SRC_MAX];
+  strcpy(buf, src);
+  for (char *clause = strtok(buf, ";"); clause && !fail;
+       clause = strtok(nullptr, ";")) {
+    while (*clause == ' ')
+      clause++;
+    failAt = clause - buf;
+    char word[8];
+    int used = 0;
+    if (sscanf(clause, "%7s%n", word, &used) != 1)
+      continue; // empty clause
+    const char *s = clause + used;
+    while (*s == ' ')
+      s++;
+    long v, w;
+    char *e;
+
+    if (strcmp(word, "at") == 0) {
+      int h, m, n;
+      while (sscanf(s, "%d:%d%n", &h, &m, &n) == 2) {
+        if (h > 23 || m > 59 || h < 0 || m < 0 || nAt == RX_MAX_AT) {
+          fail = "at: HH:MM, up to 6 times";
+          break;
+        }
+        at[nAt++] = h * 60 + m;
+        s += n;
+        if (*s == ',')
+          s++;
+      }
+      if (!nAt && !fail)
+        fail = "at: HH:MM[,HH:MM...]";
+    } else if (strcmp(word, "every") == 0) {
+      v = parseSpan(s, true);
+      if (v < 1 || v > 255)
+        fail = "every: 1d-255d";
+      else
+        ok &= emit(code, {RX_EVERY, (int)v});
+    } else if (strcmp(word, "for") == 0) {
+      v = parseSpan(s, true);
+      if (v < 1 || v > 65535)
+        fail = "for: Nd";
+      else
+        ok &= emit(code, {RX_COURSE, (int)(v & 0xFF), (int)(v >> 8)});
+    } else if (strcmp(word, "pills") == 0) {
+      v = strtol(s, &e, 10);
+      s = e;
+      if (taper)
+        fail = "pills: not with taper";
+      else if (v < 1 || v > 9)
+        fail = "pills: 1-9";
+      else
+        ok &= emit(code, {RX_PILLS, (int)v});
+      pills = true;
+    } else if (strcmp(word, "taper") == 0) {
+      uint8_t q[8];
+      int n = 0;
+      while ((v = strtol(s, &e, 10)) != 0 || e != s) {
+        if (v < 1 || v > 9) {
+          fail = "taper: 1-9 pills per step";
+          break;
+        }
+        if (n == 8) {
+          fail = "taper: up to 8 steps";
+          break;
+        }
+        q[n++] = v;
+        s = e;
+        if (*s != ',')
+          break;
+        s++;
+      }
+      w = *s == '/' ? parseSpan(++s, true) : -1;
+      if (!fail && pills) {
+        fail = "taper: not with pills";
+      } else if (!fail && (!n || w < 1 || w > 255)) {
+        fail = "taper: n,n,.../Nd, step 1d-255d";
+      } else if (!fail) {
+        ok &= emit(code, {RX_TAPER, (int)w, n});
+        for (int i = 0; i < n; i++)
+          ok &= emit(code, {q[i]});
+      }
+      taper = true;
+    } else if (strcmp(word, "prn") == 0) {
+      prn = true;
+      ok &= emit(code, {RX_PRN});
+    } else if (strcmp(word, "gap") == 0) {
+      v = parseSpan(s, false);
+      if (v < 1 || v > 7 * 1440)
+        fail = "gap: Nh or Nm, up to 7d";
+      else
+        ok &= emit(code, {RX_GAP, (int)(v & 0xFF), (int)(v >> 8)});
+    } else if (strcmp(word, "max") == 0) {
+      v = strtol(s, &e, 10);
+      s = e;
+      w = *s == '/' ? parseSpan(++s, false) : -1;
+      if (v < 1 || v > RX_HISTORY || w < 1 || w > 7 * 1440)
+        fail = "max: N/Nh, N up to 8, up to 7d";
+      else
+        ok &= emit(code, {RX_MAX, (int)v, (int)(w & 0xFF), (int)(w >> 8)});
+    } else {
+      fail = "unknown clause";
+    }
+
+    // Nothing but blanks before the next ';': `gap 4h30m` is not 4 h
+    while (!fail && *s == ' ')
+      s++;
+    if (!fail && *s) {
+      fail = "unexpected text";
+      failAt = s - buf;
+    }
+  }
+  if (!fail && !nAt && !prn) {
+    fail = "needs dose times (at) or prn";
+    failAt = -1;
+  }
+
+  // Dose times last, in order
+  for (int i = 1; i < nAt; i++)
+    for (int j = i; j > 0 && at[j] < at[j - 1]; j--) {
+      uint16_t t = at[j];
+      at[j] = at[j - 1];
+      at[j - 1] = t;
+    }
+  for (int i = 0; i < nAt; i++)
+    ok &= emit(code, {RX_AT, at[i] / 60, at[i] % 60});
+  if (!fail && !ok) {
+    fail = "too long";
+    failAt = -1;
+  }
+
+  if (fail) {
+    if (failAt >= 0)
+      snprintf(err, errLen, "%s (at %d)", fail, failAt);
+    else
+      snprintf(err, errLen, "%s", fail);
+    code.len = 0;
+    return false;
+  }
+  return true;
+}
+
+// ============================================================
+// Evaluation
+// ============================================================
+int rxPillsAt(const RxCode &code, uint32_t startDay, uint32_t t) {
+  RxPlan p;
+  decode(code, p);
+  uint16_t tod = t % 86400 / 60;
+  for (int i = 0; i < p.nAt; i++)
+    if (p.at[i] == tod)
+      return pillsOn(p, (int32_t)(t / 86400 - startDay));
+  return 0;
+}
+
+uint32_t rxNextDue(const RxCode &code, uint32_t startDay, uint32_t after) {
+  RxPlan p;
+  decode(code, p);
+  if (!p.nAt)
+    return 0;
+  uint32_t day = after / 86400 > startDay ? after / 86400 : startDay;
+  for (int n = 0; n < RX_LOOKAHEAD_DAYS; n++, day++) {
+    int32_t d = day - startDay;
+    if ((p.course && d >= p.course) ||
+        (p.taperN && d / p.taperStep >= p.taperN))
+      return 0; // course over
+    if (!pillsOn(p, d))
+      continue;
+    for (int i = 0; i < p.nAt; i++) {
+      uint32_t t = day * 86400 + p.at[i] * 60;
+      if (t > after)
+        return t;
+    }
+  }
+  return 0;
+}
+
+uint32_t rxLockout(const RxCode &code, const uint32_t *history, int n,
+                   uint32_t t) {
+  RxPlan p;
+  decode(code, p);
+  uint32_t wait = 0;
+  if (p.gapMin && n) {
+    uint32_t next = history[0] + p.gapMin * 60UL;
+    if (t < next)
+      wait = next - t;
+  }
+  if (p.maxN && n >= p.maxN) {
+    // Window holds maxN doses when the maxN-th newest is inside it; the
+    // dose can go once that one leaves
+    uint32_t next = history[p.maxN - 1] + p.windowMin * 60UL;
+    if (t < next && next - t > wait)
+      wait = next - t;
+  }
+  return wait;
+}
+
+// ============================================================
+// Per-module regimens
+// ============================================================
+struct Regimen {
+  char src[RX_SRC_MAX];
+  RxCode code; // len 0 = none
+  uint32_t startDay;
+  uint32_t history[RX_HISTORY]; // dose epochs, newest first
+  uint8_t histLen;
+};
+
+static Regimen regimens[NUM_MODULES];
+static Preferences rxPrefs;
+
+static void saveRegimen(int m) {
+  char key[4] = {'s', (char)('0' + m), 0};
+  rxPrefs.begin("rx", false);
+  Regimen &r = regimens[m];
+  if (!r.code.len) {
+    for (char k : {'s', 'c', 'd', 'h'}) {
+      key[0] = k;
+      rxPrefs.remove(key);
+    }
+  } else {
+    rxPrefs.putString(key, r.src);
+    key[0] = 'c';
+    rxPrefs.putBytes(key, r.code.op, r.code.len);
+    key[0] = 'd';
+    rxPrefs.putUInt(key, r.startDay);
+    key[0] = 'h';
+    rxPrefs.putBytes(key, r.history, r.histLen * sizeof(uint32_t));
+  }
+  rxPrefs.end();
+}
+
+static void loadRegimens(void) {
+  rxPrefs.begin("rx", true);
+  for (int m = 0; m < NUM_MODULES; m++) {
+    Regimen &r = regimens[m];
+    char key[4] = {'c', (char)('0' + m), 0};
+    r.code.len = rxPrefs.getBytes(key, r.code.op, RX_CODE_MAX);
+    key[0] = 's';
+    String src = rxPrefs.getString(key, "");
+    strncpy(r.src, src.c_str(), RX_SRC_MAX - 1);
+    r.src[RX_SRC_MAX - 1] = '\0';
+    key[0] = 'd';
+    r.startDay = rxPrefs.getUInt(key, 0);
+    key[0] = 'h';
+    r.histLen = rxPrefs.getBytes(key, r.history, sizeof(r.history)) /
+                sizeof(uint32_t);
+  }
+  rxPrefs.end();
+}
+
+bool rxActive(int m) { return regimens[m].code.len != 0; }
+
+bool rxHasPrn(int m) {
+  if (!rxActive(m))
+    return false;
+  RxPlan p;
+  decode(regimens[m].code, p);
+  return p.prn;
+}
+
+int rxPills(int m, uint32_t t) {
+  const Regimen &r = regimens[m];
+  return r.code.len ? rxPillsAt(r.code, r.startDay, t) : 0;
+}
+
+uint32_t rxNext(int m, uint32_t after) {
+  const Regimen &r = regimens[m];
+  return r.code.len ? rxNextDue(r.code, r.startDay, after) : 0;
+}
+
+uint32_t rxWait(int m, uint32_t t) {
+  const Regimen &r = regimens[m];
+  return r.code.len ? rxLockout(r.code, r.history, r.histLen, t) : 0;
+}
+
+void rxRecord(int m, uint32_t t) {
+  Regimen &r = regimens[m];
+  if (!r.code.len)
+    return;
+  memmove(&r.history[1], &r.history[0],
+          (RX_HISTORY - 1) * sizeof(uint32_t));
+  r.history[0] = t;
+  if (r.histLen < RX_HISTORY)
+    r.histLen++;
+  saveRegimen(m);
+}
+
+// ============================================================
+// `rx sim` — months of minutes through the evaluator: scheduled doses
+// are taken, PRN is asked for every RX_SIM_ASK_MIN; each PRN dose is
+// checked against gap / max independently of rxLockout()
+// ============================================================
+#define RX_SIM_ASK_MIN 30
+
+static void simulate(int m, int days) {
+  const Regimen &r = regimens[m];
+  RxPlan p;
+  decode(r.code, p);
+  uint32_t hist[RX_HISTORY];
+  int histLen = 0;
+  uint32_t taken[64]; // every dose, ring, for the independent check
+  int takenN = 0;
+  uint32_t doses = 0, pills = 0, held = 0, prnTaken = 0, prnLocked = 0;
+  uint32_t bad = 0;
+  uint32_t checks = 0, cycles = 0;
+
+  uint32_t t0 = r.startDay * 86400;
+  for (uint32_t t = t0; t < t0 + days * 86400UL; t += 60) {
+    uint32_t c = profStamp();
+    int n = rxPillsAt(r.code, r.startDay, t);
+    cycles += profStamp() - c;
+    checks++;
+    bool ask = p.prn && (t / 60) % RX_SIM_ASK_MIN == 0;
+    if (!n && !ask)
+      continue;
+    if (rxLockout(r.code, hist, histLen, t)) {
+      if (n)
+        held++; // a scheduled dose inside a lockout
+      else
+        prnLocked++;
+      continue;
+    }
+    if (n) {
+      doses++;
+      pills += n;
+    } else {
+      prnTaken++;
+    }
+
+    // Independent check over the full record
+    int inWindow = 1;
+    for (int i = 0; i < takenN && i < 64; i++) {
+      uint32_t prev = taken[(takenN - 1 - i) % 64];
+      if (i == 0 && p.gapMin && t - prev < p.gapMin * 60UL)
+        bad++;
+      if (p.maxN && t - prev < p.windowMin * 60UL)
+        inWindow++;
+    }
+    if (p.maxN && inWindow > p.maxN)
+      bad++;
+    taken[takenN++ % 64] = t;
+
+    memmove(&hist[1], &hist[0], (RX_HISTORY - 1) * sizeof(uint32_t));
+    hist[0] = t;
+    histLen += histLen < RX_HISTORY;
+  }
+  uint32_t mhz = ESP.getCpuFreqMHz();
+  Serial.printf("[Rx] module %d, %d days: %lu doses (%lu pills, %lu held "
+                "back), PRN %lu taken / %lu locked out\n",
+                m + 1, days, (unsigned long)doses, (unsigned long)pills,
+                (unsigned long)held, (unsigned long)prnTaken,
+                (unsigned long)prnLocked);
+  Serial.printf("  %s\n", bad ? "LOCKOUT VIOLATED" : "gap / max held");
+  Serial.printf("  %lu checks, %.2f us per check\n", (unsigned long)checks,
+                (float)cycles / mhz / checks);
+}
+
+// ============================================================
+// `rx`
+//   rx                      regimens, next dose, lockout
+//   rx <module> <regimen>   compile and set (day 0 = today)
+//   rx <module> off
+//   rx prn <module>         ask for an as-needed dose
+//   rx sim <module> [days]  evaluate a course minute by minute
+// ============================================================
+static void rxCommand(const char *args) {
+  int m, n = 0, days = 90;
+  uint32_t now = timeEpoch();
+  if (sscanf(args, "sim %d %d", &m, &days) >= 1) {
+    if (m < 1 || m > NUM_MODULES || !rxActive(m - 1) || days < 1 ||
+        days > 366) {
+      Serial.println("[Rx] sim: module with a regimen, 1-366 days");
+      return;
+    }
+    simulate(m - 1, days);
+    return;
+  }
+  if (sscanf(args, "prn %d", &m) == 1) {
+    if (m < 1 || m > NUM_MODULES || !rxHasPrn(m - 1)) {
+      Serial.println("[Rx] No PRN regimen on that module");
+      return;
+    }
+    uint32_t wait = rxWait(m - 1, now);
+    if (wait) {
+      Serial.printf("[Rx] Locked out for %lu min\n",
+                    (unsigned long)(wait + 59) / 60);
+      return;
+    }
+    // `pills` / `taper` set the count, `every` / `for` the days
+    const Regimen &r = regimens[m - 1];
+    RxPlan p;
+    decode(r.code, p);
+    int pills = pillsOn(p, (int32_t)(now / 86400 - r.startDay));
+    if (!pills) {
+      Serial.println("[Rx] No PRN dose today (course or dosing days)");
+      return;
+    }
+    schedulerRequestDose(m - 1, pills);
+    return;
+  }
+  if (sscanf(args, "%d %n", &m, &n) == 1 && n) {
+    if (m < 1 || m > NUM_MODULES) {
+      Serial.println("[Rx] module 1-6");
+      return;
+    }
+    Regimen &r = regimens[m - 1];
+    const char *src = args + n;
+    if (strcmp(src, "off") == 0) {
+      r.code.len = 0;
+      r.src[0] = '\0';
+    } else {
+      char err[64];
+      RxCode code;
+      if (!rxCompile(src, code, err, sizeof(err))) {
+        Serial.printf("[Rx] %s\n", err);
+        return;
+      }
+      r.code = code;
+      strcpy(r.src, src); // rxCompile() checked the length
+      r.startDay = now / 86400; // history stays: those doses were taken
+    }
+    saveRegimen(m - 1);
+    schedulerRegimenChanged(m - 1);
+  } else if (*args) {
+    Serial.println("usage: rx [<module> <regimen>|off | prn <module> | "
+                   "sim <module> [days]]");
+    return;
+  }
+
+  for (int i = 0; i < NUM_MODULES; i++) {
+    const Regimen &r = regimens[i];
+    if (!r.code.len)
+      continue;
+    Serial.printf("  %d: %s  (%d B, day %ld)\n", i + 1, r.src, r.code.len,
+                  (long)(now / 86400 - r.startDay));
+    uint32_t next = rxNext(i, now), wait = rxWait(i, now);
+    if (next)
+      Serial.printf("     next %02lu:%02lu, %d pill(s)",
+                    (unsigned long)(next % 86400 / 3600),
+                    (unsigned long)(next / 60 % 60), rxPills(i, next));
+    else
+      Serial.printf("     no scheduled dose");
+    Serial.printf(", %d recent dose(s)", r.histLen);
+    if (wait)
+      Serial.printf(", locked out %lu min", (unsigned long)(wait + 59) / 60);
+    Serial.println();
+  }
+}
+
+void rxSetup(void) {
+  loadRegimens();
+  consoleRegister("rx", rxCommand,
+                  "[<m> <regimen>|off|prn <m>|sim <m> [d]] regimens");
+}
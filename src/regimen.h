@@ -0,0 +1,58 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Regimens
+// A per-module prescription in a small text language, compiled when it
+// is set into a few bytes of bytecode that the scheduler evaluates (a
+// check is a walk over at most RX_CODE_MAX bytes). Clauses, separated
+// by ';':
+//   at 08:00,20:00       dose times of day (up to RX_MAX_AT)
+//   every 2d             dosing days: every other day from the start
+//   for 10d              course length
+//   pills 2              pills per dose (default 1)
+//   taper 4,3,2,1/5d     pills per dose stepping down every 5 days; the
+//                        course ends after the last step
+//   prn                  as needed (`rx prn <module>`), with or
+//                        without dose times
+//   gap 4h               at least this long between two doses
+//   max 3/24h            at most 3 doses in any 24 h
+// Day 0 is the day the regimen was set. Every dose the module gets —
+// scheduled or PRN — is kept in a short history; gap and max are
+// checked against it as sliding windows before the servo moves.
+// ============================================================
+#define RX_SRC_MAX 64  // source text per module, terminator included
+#define RX_CODE_MAX 32 // bytecode per module
+#define RX_MAX_AT 6
+#define RX_HISTORY 8   // doses remembered, so `max` is at most this
+#define RX_LOOKAHEAD_DAYS 400
+
+struct RxCode {
+  uint8_t len;
+  uint8_t op[RX_CODE_MAX];
+};
+
+// --- Compiler / evaluator ---
+// false with a message in `err` when the source does not parse, is too
+// long, or has anything but blanks after a clause; the message gives the
+// character offset where that can be pinned down
+bool rxCompile(const char *src, RxCode &code, char *err, int errLen);
+// Pills due in the minute starting at `t`, 0 if none; `startDay` is the
+// epoch day (epoch / 86400) of day 0
+int rxPillsAt(const RxCode &code, uint32_t startDay, uint32_t t);
+// First dose minute after `after`, 0 if none within RX_LOOKAHEAD_DAYS
+uint32_t rxNextDue(const RxCode &code, uint32_t startDay, uint32_t after);
+// Seconds until a dose at `t` is allowed by gap / max, 0 = now.
+// `history` holds dose epochs, newest first.
+uint32_t rxLockout(const RxCode &code, const uint32_t *history, int n,
+                   uint32_t t);
+
+// --- Per-module regimens (NVS) ---
+void rxSetup(void); // loads them; registers `rx`
+bool rxActive(int module);
+bool rxHasPrn(int module);
+int rxPills(int module, uint32_t t);
+uint32_t rxNext(int module, uint32_t after);
+uint32_t rxWait(int module, uint32_t t); // lockout, see rxLockout()
+void rxRecord(int module, uint32_t t);  // a dose was dispensed
@@ -1,21 +1,41 @@
 #include "scheduler.h"
+#include "console.h"
+#include "dose_calendar.h"
+#include "regimen.h"
+#include "timebase.h"
 #include <Preferences.h>
 #include <RTClib.h>
-#include <Wire.h>
+#include <atomic>
+#include <esp_timer.h>
 
 // ============================================================
-// RTC + Data Storage
+// Data Storage
 // ============================================================
-static RTC_DS3231 rtc;
-static bool rtcFound = false;
 static Preferences prefs;
 static TimeSlot timeSlots[NUM_TIME_SLOTS];
 static MedModule modules[NUM_MODULES];
 static DispenseCallback dispenseCallback = nullptr;
-static bool dispensedToday[NUM_TIME_SLOTS] = {false};
-static uint8_t lastMinute = 99;
 static bool masterEnabled = true;
 
+// Dose calendar: rules 0..NUM_TIME_SLOTS-1 mirror the meal-grid slots,
+// the rest have their own times (`cal add`) or stand for a module's
+// regimen: a one-shot rule moved to the regimen's next dose each time
+#define SLOT_OWN -1
+#define SLOT_REGIMEN -2
+static DoseRule rules[SCHED_MAX_RULES];
+static uint16_t ruleHeap[SCHED_MAX_RULES];
+static DoseCalendar cal;
+
+// Next dose: one timer armed for the calendar's top
+static esp_timer_handle_t fireTimer = nullptr;
+static std::atomic<bool> fireDue{false};
+
+// Every occurrence at or before this epoch has been raised or skipped;
+// kept in NVS so a reboot catches up from here
+static uint32_t doneUntil = 0;
+static uint32_t missedDoses = 0; // past the grace window (`cal`)
+static uint8_t dosePills[NUM_MODULES]; // per module, last raised dose
+
 // Default time slot values
 static const uint8_t defaultHours[NUM_TIME_SLOTS] = {8, 8, 12, 12, 17, 17, 21};
 static const uint8_t defaultMins[NUM_TIME_SLOTS] = {0, 30, 0, 30, 0, 30, 0};
@@ -23,60 +43,213 @@ static const uint8_t defaultMins[NUM_TIME_SLOTS] = {0, 30, 0, 30, 0, 30, 0};
 // ============================================================
 // Setup
 // ============================================================
+static void onFireTimer(void *) {
+  fireDue.store(true, std::memory_order_relaxed);
+}
+
+static void arm(void);
+static void calCommand(const char *args);
+
 void schedulerSetup(void) {
-  if (rtc.begin()) {
-    rtcFound = true;
-    if (rtc.lostPower()) {
-      Serial.println("[RTC] Lost power — setting to compile time");
-      rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
-    }
-    DateTime now = rtc.now();
-    Serial.printf("[RTC] OK — %04d-%02d-%02d %02d:%02d:%02d\n", now.year(),
-                  now.month(), now.day(), now.hour(), now.minute(),
-                  now.second());
+  esp_timer_create_args_t args = {};
+  args.callback = onFireTimer;
+  args.name = "dose";
+  esp_timer_create(&args, &fireTimer);
+  timeSetAdjustCallback(arm); // due times are absolute: only re-arm
+  schedulerLoad();
+  consoleRegister("cal", calCommand,
+                  "[add|del|bench] dose rules beyond the meal grid");
+}
+
+// ============================================================
+// Next fire time
+// Slot i fires when it is enabled and at least one module takes from
+// it; its rule carries those modules. Changing slots, masks or the
+// master switch replans the affected rules, and a one-shot timer is
+// armed for the calendar's top — between doses schedulerLoop() only
+// reads a flag.
+// ============================================================
+static int slotSecond(int i) {
+  return timeSlots[i].hour * 3600 + timeSlots[i].minute * 60;
+}
+
+static void fillSlotRule(DoseRule &r, int i) {
+  r.start = slotSecond(i);
+  r.period = CAL_DAILY;
+  r.days = CAL_EVERY_DAY;
+  r.slot = i;
+  r.enabled = timeSlots[i].enabled;
+  r.modules = 0;
+  for (int m = 0; m < NUM_MODULES; m++)
+    if (modules[m].slotMask & (1 << i))
+      r.modules |= 1 << m;
+}
+
+static void syncSlotRule(int i, uint32_t now) {
+  fillSlotRule(rules[i], i);
+  calUpdate(cal, i, now);
+}
+
+static int findRegimenRule(int m) {
+  for (int id = NUM_TIME_SLOTS; id < cal.count; id++)
+    if (rules[id].slot == SLOT_REGIMEN && rules[id].modules == 1 << m)
+      return id;
+  return -1;
+}
+
+// Module m's regimen rule at its first dose after `after`; removed when
+// the regimen has none (cleared, or the course is over)
+static void syncRegimenRule(int m, uint32_t after) {
+  uint32_t next = rxNext(m, after);
+  int id = findRegimenRule(m);
+  if (!next) {
+    calRemove(cal, id);
+  } else if (id >= 0) {
+    rules[id].start = next;
+    calUpdate(cal, id, after);
   } else {
-    Serial.println("[RTC] Not found — using millis fallback");
+    DoseRule r = {};
+    r.start = next;
+    r.period = 0; // once; moved on after each dose
+    r.days = CAL_EVERY_DAY;
+    r.modules = 1 << m;
+    r.slot = SLOT_REGIMEN;
+    r.enabled = true;
+    if (calAdd(cal, r, after) < 0)
+      Serial.printf("[Scheduler] Calendar full, regimen %d not queued\n", m);
   }
+}
 
-  schedulerLoad();
+static uint32_t nextFire(void) {
+  const DoseRule *top = calPeek(cal);
+  return masterEnabled && top ? top->next : 0;
+}
+
+static void arm(void) {
+  fireDue.store(false, std::memory_order_relaxed);
+  if (!fireTimer)
+    return; // before setup: schedulerSetup() plans after loading
+  esp_timer_stop(fireTimer);
+  uint32_t at = nextFire();
+  if (!at)
+    return;
+  int64_t us = timeEpochUs(at) - esp_timer_get_time();
+  esp_timer_start_once(fireTimer, us > 0 ? us : 1);
+}
+
+// Slot rules from the meal grid, then the timer
+static void replanSlots(void) {
+  uint32_t now = timeEpoch();
+  for (int i = 0; i < NUM_TIME_SLOTS; i++)
+    syncSlotRule(i, now);
+  arm();
+}
+
+static void saveDoneUntil(void) {
+  prefs.begin("sched2", false);
+  prefs.putUInt("done", doneUntil);
+  prefs.end();
 }
 
 // ============================================================
-// Loop — check if any time slot triggers
+// Loop — raises every dose due by now
+// Normally that is the one the timer was armed for. After a stall (a
+// blocking portal, a long dose) or a reboot it can be several: those
+// less than SCHED_GRACE_MIN late are raised together as one dose, each
+// module once; older ones are logged as missed and skipped.
 // ============================================================
 void schedulerLoop(void) {
-  if (!masterEnabled)
+  if (!fireDue.load(std::memory_order_relaxed))
     return;
-  if (millis() < 30000)
-    return; // Grace period
-
-  uint8_t h, m, s;
-  schedulerGetTime(h, m, s);
-
-  if (m == lastMinute)
+  uint32_t now = timeEpoch();
+  uint32_t at = nextFire();
+  if (!at || now < at) {
+    arm(); // timer ran ahead of the drift-corrected clock
     return;
-  lastMinute = m;
-
-  // Reset at midnight
-  if (h == 0 && m == 0) {
-    for (int i = 0; i < NUM_TIME_SLOTS; i++)
-      dispensedToday[i] = false;
   }
 
-  // Check each time slot
-  for (int i = 0; i < NUM_TIME_SLOTS; i++) {
-    if (!timeSlots[i].enabled)
-      continue;
-    if (dispensedToday[i])
-      continue;
-    if (timeSlots[i].hour == h && timeSlots[i].minute == m) {
-      dispensedToday[i] = true;
-      Serial.printf("[Scheduler] Trigger slot %d at %02d:%02d\n", i, h, m);
-      if (dispenseCallback) {
-        dispenseCallback(i);
+  int slot = -1;
+  uint8_t mods = 0;
+  uint32_t first = 0;
+  memset(dosePills, 0, sizeof(dosePills));
+  const DoseRule *top;
+  while ((top = calPeek(cal)) && top->next <= now) {
+    uint32_t due = top->next;
+    int8_t kind = top->slot;
+    uint8_t ruleMods = top->modules;
+    if (now - due < SCHED_GRACE_MIN * 60UL) {
+      if (!mods) {
+        slot = kind >= 0 ? kind : -1;
+        first = due;
       }
+      mods |= ruleMods;
+      // Pills: the regimen's count (a taper step), else one
+      for (int m = 0; m < NUM_MODULES; m++) {
+        if (!(ruleMods & (1 << m)))
+          continue;
+        int n = kind == SLOT_REGIMEN ? rxPills(m, due) : 1;
+        dosePills[m] = n > dosePills[m] ? n : dosePills[m];
+      }
+    } else {
+      missedDoses++;
+      Serial.printf("[Scheduler] Missed slot %d modules 0x%02X due "
+                    "%02lu:%02lu (%lu min late)\n",
+                    top->slot, top->modules,
+                    (unsigned long)(due % 86400 / 3600),
+                    (unsigned long)(due / 60 % 60),
+                    (unsigned long)((now - due) / 60));
+    }
+    calTake(cal);
+    if (kind == SLOT_REGIMEN)
+      syncRegimenRule(__builtin_ctz(ruleMods), due);
+  }
+  doneUntil = now;
+  saveDoneUntil();
+
+  if (mods) {
+    int late = (int)((esp_timer_get_time() - timeEpochUs(first)) / 1000);
+    Serial.printf("[Scheduler] Trigger slot %d modules 0x%02X at "
+                  "%02lu:%02lu (+%d ms)\n",
+                  slot, mods, (unsigned long)(first % 86400 / 3600),
+                  (unsigned long)(first / 60 % 60), late);
+    if (dispenseCallback) {
+      dispenseCallback(slot, mods);
     }
   }
+  arm();
+}
+
+int64_t schedulerNextFireUs(void) {
+  uint32_t at = nextFire();
+  return at ? timeEpochUs(at) : -1;
+}
+
+bool schedulerNextDose(uint32_t &at, int &slot, uint8_t &mods) {
+  at = nextFire();
+  if (!at)
+    return false;
+  const DoseRule *top = calPeek(cal);
+  slot = top->slot >= 0 ? top->slot : -1;
+  mods = top->modules;
+  return true;
+}
+
+uint8_t schedulerDosePills(int module) {
+  return module >= 0 && module < NUM_MODULES ? dosePills[module] : 0;
+}
+
+void schedulerRequestDose(int module, uint8_t pills) {
+  memset(dosePills, 0, sizeof(dosePills));
+  dosePills[module] = pills;
+  Serial.printf("[Scheduler] Dose requested for module %d\n", module);
+  if (dispenseCallback) {
+    dispenseCallback(-1, 1 << module);
+  }
+}
+
+void schedulerRegimenChanged(int module) {
+  syncRegimenRule(module, timeEpoch());
+  arm();
 }
 
 // ============================================================
@@ -90,6 +263,8 @@ void timeSlotSet(int index, uint8_t h, uint8_t m, bool en) {
   timeSlots[index].hour = h;
   timeSlots[index].minute = m;
   timeSlots[index].enabled = en;
+  syncSlotRule(index, timeEpoch());
+  arm();
 }
 
 // ============================================================
@@ -114,6 +289,7 @@ void moduleSetSlotMask(int index, uint8_t mask) {
   if (index < 0 || index >= NUM_MODULES)
     return;
   modules[index].slotMask = mask;
+  replanSlots();
 }
 
 void moduleToggleSlot(int index, int slotBit) {
@@ -122,6 +298,8 @@ void moduleToggleSlot(int index, int slotBit) {
   if (slotBit < 0 || slotBit >= NUM_TIME_SLOTS)
     return;
   modules[index].slotMask ^= (1 << slotBit);
+  syncSlotRule(slotBit, timeEpoch());
+  arm();
 }
 
 // ============================================================
@@ -151,6 +329,26 @@ void schedulerSave(void) {
     prefs.putUChar(keyS.c_str(), modules[i].slotMask);
   }
 
+  // Nothing before now is owed unless a due dose is still queued, so
+  // rules edited since the last dose don't come due on the next boot
+  const DoseRule *top = calPeek(cal);
+  uint32_t now = timeEpoch();
+  if (!top || top->next > now)
+    doneUntil = now;
+  prefs.putUInt("done", doneUntil);
+
+  // Own-time dose rules (slot and regimen rules follow from the above
+  // and from the regimens)
+  DoseRule own[SCHED_MAX_RULES];
+  int n = 0;
+  for (int id = NUM_TIME_SLOTS; id < cal.count; id++)
+    if (rules[id].slot == SLOT_OWN)
+      own[n++] = rules[id];
+  if (n > 0)
+    prefs.putBytes("rules", own, n * sizeof(DoseRule));
+  else
+    prefs.remove("rules");
+
   prefs.end();
   Serial.println("[Scheduler] Saved to NVS");
 }
@@ -187,7 +385,7 @@ void schedulerLoad(void) {
     String keyS = "ms" + String(i);
     String name = prefs.getString(keyN.c_str(), "");
     if (name.length() == 0) {
-      snprintf(modules[i].name, MAX_MED_NAME, "ตลับ %d", i + 1);
+      snprintf(modules[i].name, MAX_MED_NAME, "Slot %d", i + 1);
     } else {
       strncpy(modules[i].name, name.c_str(), MAX_MED_NAME - 1);
       modules[i].name[MAX_MED_NAME - 1] = '\0';
@@ -196,7 +394,33 @@ void schedulerLoad(void) {
     modules[i].slotMask = prefs.getUChar(keyS.c_str(), 0);
   }
 
+  // Dose rules: one per slot, then the own-time ones, planned from
+  // where the last run left off so doses missed while off come due now
+  uint32_t now = timeEpoch();
+  uint32_t from = prefs.getUInt("done", 0);
+  if (!from || from > now) // first boot, or the RTC was reset
+    from = now;
+  if (now - from > SCHED_CATCHUP_H * 3600UL)
+    from = now - SCHED_CATCHUP_H * 3600UL;
+  doneUntil = from;
+  calInit(cal, rules, ruleHeap, SCHED_MAX_RULES);
+  for (int i = 0; i < NUM_TIME_SLOTS; i++) {
+    DoseRule r = {};
+    fillSlotRule(r, i);
+    calAdd(cal, r, from);
+  }
+  DoseRule own[SCHED_MAX_RULES - NUM_TIME_SLOTS];
+  size_t len = prefs.getBytesLength("rules");
+  int n = 0;
+  if (len % sizeof(DoseRule) == 0 && len <= sizeof(own))
+    n = prefs.getBytes("rules", own, len) / sizeof(DoseRule);
+  for (int i = 0; i < n; i++)
+    calAdd(cal, own[i], from);
+  for (int m = 0; m < NUM_MODULES; m++)
+    syncRegimenRule(m, from);
+
   prefs.end();
+  arm();
   Serial.println("[Scheduler] Loaded from NVS");
   for (int i = 0; i < NUM_TIME_SLOTS; i++) {
     Serial.printf("  TimeSlot %d: %02d:%02d %s\n", i, timeSlots[i].hour,
@@ -212,62 +436,124 @@ void schedulerLoad(void) {
 // Next upcoming slot
 // ============================================================
 int schedulerNextSlot(void) {
-  uint8_t h, m, s;
-  schedulerGetTime(h, m, s);
-  int nowMin = h * 60 + m;
+  uint32_t at;
+  int slot;
+  uint8_t mods;
+  return schedulerNextDose(at, slot, mods) ? slot : -1;
+}
 
-  int bestSlot = -1;
-  int bestDist = 9999;
+// ============================================================
+// `cal` — dose rules beyond the meal grid
+//   cal                                 list rules and their next dose
+//   cal add <module> <HH:MM> [hours] [days]
+//                                      e.g. `cal add 2 06:00 8` or
+//                                      `cal add 3 09:00 24 0111110`
+//                                      (days: 7 digits, Sunday first)
+//   cal del <n>                         own-time rules only
+//   cal bench                           calendar insert / peek / take
+// ============================================================
+static void printRule(int id) {
+  const DoseRule &r = rules[id];
+  char days[8];
+  for (int d = 0; d < 7; d++)
+    days[d] = r.days & (1 << d) ? "SMTWTFS"[d] : '-';
+  days[7] = '\0';
+  if (r.slot == SLOT_REGIMEN) {
+    Serial.printf("  %2d rx   module %d regimen", id,
+                  __builtin_ctz(r.modules) + 1);
+  } else {
+    Serial.printf("  %2d %s %02lu:%02lu every %2luh %s modules 0x%02X", id,
+                  r.slot >= 0 ? "slot" : "own ",
+                  (unsigned long)(r.start % 86400 / 3600),
+                  (unsigned long)(r.start / 60 % 60),
+                  (unsigned long)(r.period / 3600), days, r.modules);
+  }
+  if (r.next) {
+    DateTime t(r.next);
+    Serial.printf("  next %02d-%02d %02d:%02d\n", t.month(), t.day(),
+                  t.hour(), t.minute());
+  } else {
+    Serial.println("  off");
+  }
+}
 
-  for (int i = 0; i < NUM_TIME_SLOTS; i++) {
-    if (!timeSlots[i].enabled)
-      continue;
-    int slotMin = timeSlots[i].hour * 60 + timeSlots[i].minute;
-    int dist = slotMin - nowMin;
-    if (dist <= 0)
-      dist += 1440; // wrap to next day
-    if (dist < bestDist) {
-      bestDist = dist;
-      bestSlot = i;
+static void calCommand(const char *args) {
+  if (strcmp(args, "bench") == 0) {
+    calBench();
+    return;
+  }
+  int mod, h, m, hours = 24;
+  char days[8] = "1111111";
+  if (sscanf(args, "add %d %d:%d %d %7s", &mod, &h, &m, &hours, days) >= 3) {
+    if (mod < 1 || mod > NUM_MODULES || h > 23 || m > 59 || hours < 1 ||
+        hours > 168) {
+      Serial.println("[Cal] module 1-6, HH:MM, every 1-168 h");
+      return;
+    }
+    DoseRule r = {};
+    uint32_t now = timeEpoch();
+    r.start = now - now % 86400 + h * 3600 + m * 60; // today, at HH:MM
+    r.period = hours * 3600;
+    for (int d = 0; d < 7 && days[d]; d++)
+      r.days |= (days[d] == '1') << d;
+    r.modules = 1 << (mod - 1);
+    r.slot = SLOT_OWN;
+    r.enabled = true;
+    int id = calAdd(cal, r, now);
+    if (id < 0) {
+      Serial.println("[Cal] Calendar full");
+      return;
+    }
+    arm();
+    schedulerSave();
+    printRule(id);
+    return;
+  }
+  int id;
+  if (sscanf(args, "del %d", &id) == 1) {
+    if (id < NUM_TIME_SLOTS || id >= cal.count ||
+        rules[id].slot != SLOT_OWN) {
+      Serial.println("[Cal] Not an own-time rule (slots are set on screen)");
+      return;
     }
+    calRemove(cal, id);
+    arm();
+    schedulerSave();
+  } else if (*args) {
+    Serial.println("usage: cal [add <module> <HH:MM> [hours] [days] | "
+                   "del <n> | bench]");
+    return;
   }
-  return bestSlot;
+  Serial.printf("[Cal] %d rules, %d queued%s; %lu missed (grace %d min)\n",
+                cal.count, cal.queued, masterEnabled ? "" : " (schedule off)",
+                (unsigned long)missedDoses, SCHED_GRACE_MIN);
+  for (int i = 0; i < cal.count; i++)
+    printRule(i);
 }
 
 // ============================================================
-// RTC Time Access
+// Time Access — from the timebase, no I2C
 // ============================================================
 void schedulerGetTime(uint8_t &h, uint8_t &m, uint8_t &s) {
-  if (rtcFound) {
-    DateTime now = rtc.now();
-    h = now.hour();
-    m = now.minute();
-    s = now.second();
-  } else {
-    unsigned long sec = millis() / 1000;
-    h = (sec / 3600) % 24;
-    m = (sec / 60) % 60;
-    s = sec % 60;
-  }
+  timeOfDay(h, m, s);
 }
 
 void schedulerGetDate(uint16_t &year, uint8_t &month, uint8_t &day,
                       uint8_t &dow) {
-  if (rtcFound) {
-    DateTime now = rtc.now();
-    year = now.year();
-    month = now.month();
-    day = now.day();
-    dow = now.dayOfTheWeek();
-  } else {
-    year = 2026;
-    month = 1;
-    day = 1;
-    dow = 0;
-  }
+  timeDate(year, month, day, dow);
 }
 
-bool schedulerHasRTC(void) { return rtcFound; }
+bool schedulerHasRTC(void) { return timeHasRTC(); }
 void schedulerSetCallback(DispenseCallback cb) { dispenseCallback = cb; }
 bool schedulerIsEnabled(void) { return masterEnabled; }
-void schedulerSetEnabled(bool en) { masterEnabled = en; }
+void schedulerSetEnabled(bool en) {
+  if (en && !masterEnabled) {
+    // Doses that fell due while the schedule was off are not owed
+    doneUntil = timeEpoch();
+    calRebuild(cal, doneUntil);
+    for (int m = 0; m < NUM_MODULES; m++)
+      syncRegimenRule(m, doneUntil);
+  }
+  masterEnabled = en;
+  arm();
+}
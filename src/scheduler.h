@@ -15,7 +15,7 @@ struct TimeSlot {
 // Medicine Module — one of 6 physical pill compartments
 // ============================================================
 struct MedModule {
-  char name[MAX_MED_NAME]; // e.g. "พารา", "วิตามิน"
+  char name[MAX_MED_NAME]; // preset key, e.g. "Paracetamol"
   uint8_t qty;             // remaining pills (0-99)
   uint8_t slotMask;        // bitmask: which time slots to dispense
                            // bit 0 = เช้าก่อน, bit 1 = เช้าหลัง, ...
@@ -25,8 +25,8 @@ struct MedModule {
 // ============================================================
 // Public API
 // ============================================================
-void schedulerSetup(void);
-void schedulerLoop(void);
+void schedulerSetup(void); // after timebaseSetup()
+void schedulerLoop(void);  // fires due slots; a flag check otherwise
 
 // --- Time Slot CRUD ---
 TimeSlot &timeSlotGet(int index);
@@ -43,19 +43,32 @@ void moduleToggleSlot(int index, int slotBit);
 void schedulerSave(void);
 void schedulerLoad(void);
 
-// --- RTC Time ---
+// --- Time (timebase.h; cheap, no RTC read) ---
 void schedulerGetTime(uint8_t &h, uint8_t &m, uint8_t &s);
 void schedulerGetDate(uint16_t &year, uint8_t &month, uint8_t &day,
                       uint8_t &dow);
 bool schedulerHasRTC(void);
 
-// --- Next upcoming slot ---
+// --- Next dose (calendar top, O(1)) ---
+// slot is -1 for an own-time or regimen rule; false when none is due
+bool schedulerNextDose(uint32_t &at, int &slot, uint8_t &modules);
 int schedulerNextSlot(void); // returns slot index (0-6) or -1
+int64_t schedulerNextFireUs(void); // esp_timer time of the next dose, or -1
 
 // --- Callback for dispense trigger ---
-typedef void (*DispenseCallback)(int timeSlotIndex);
+// Everything due when the scheduler looks arrives as one call — rules of
+// the same minute, or doses caught up after a stall or reboot: the first
+// one's slot (-1 if it has its own time) and every module they dispense
+typedef void (*DispenseCallback)(int timeSlotIndex, uint8_t modules);
 void schedulerSetCallback(DispenseCallback cb);
 
+// --- Regimens (regimen.h) ---
+// Pills per module for the dose last raised, 0 = not in it
+uint8_t schedulerDosePills(int module);
+// A PRN dose: raised through the callback like a scheduled one
+void schedulerRequestDose(int module, uint8_t pills);
+void schedulerRegimenChanged(int module); // requeues its next dose
+
 // --- Schedule master enable/disable ---
 bool schedulerIsEnabled(void);
 void schedulerSetEnabled(bool en);
@@ -0,0 +1,236 @@
+#include "scroll_list.h"
+#include "anim.h"
+#include "dirty_rect.h"
+
+// ============================================================
+// Row sprite pool
+// ============================================================
+static LGFX_Sprite *target = nullptr;
+static uint16_t bgColor, thumbColor;
+static const uint16_t *rowPalette = nullptr;
+static int rowPaletteCount = 0;
+
+static LGFX_Sprite pool[LIST_POOL];
+static int poolItem[LIST_POOL]; // item drawn in each sprite, -1 = free
+static int poolW = 0, poolH = 0;
+
+// ============================================================
+// List state
+// ============================================================
+static bool active = false;
+static int16_t vx, vy, vw, vh, rowH;
+static int count = 0;
+static ListRowDraw drawRow = nullptr;
+static ListRowTap tapRow = nullptr;
+
+static float scroll = 0;   // px from the top of row 0
+static float velocity = 0; // px/ms, positive = content moving up
+static bool dragging = false;
+static bool stoppedFling = false; // press caught a fling: not a tap
+static int16_t lastY;
+static uint32_t lastMoveMs;
+static uint32_t lastFrameMs = 0;
+static bool needsCompose = false;
+
+void listSetup(LGFX_Sprite &canvas, uint16_t bg, uint16_t thumb,
+               const uint16_t *palette, int paletteCount) {
+  target = &canvas;
+  bgColor = bg;
+  thumbColor = thumb;
+  rowPalette = palette;
+  rowPaletteCount = paletteCount;
+  for (int k = 0; k < LIST_POOL; k++) {
+    pool[k].setColorDepth(UI_CANVAS_BPP);
+    pool[k].setPsram(true);
+  }
+}
+
+static int maxScroll(void) {
+  int m = count * rowH - vh;
+  return m > 0 ? m : 0;
+}
+
+static void clampScroll(void) {
+  if (scroll < 0) {
+    scroll = 0;
+    velocity = 0;
+  } else if (scroll > maxScroll()) {
+    scroll = maxScroll();
+    velocity = 0;
+  }
+}
+
+// Sprite holding `index`, drawing it into a recycled sprite on a miss.
+// Sprites whose item has left the viewport are the ones recycled.
+static LGFX_Sprite *rowSprite(int index) {
+  for (int k = 0; k < LIST_POOL; k++) {
+    if (poolItem[k] == index)
+      return &pool[k];
+  }
+  int first = (int)scroll / rowH;
+  int last = ((int)scroll + vh - 1) / rowH;
+  for (int k = 0; k < LIST_POOL; k++) {
+    int it = poolItem[k];
+    if (it < 0 || it < first || it > last) {
+      poolItem[k] = index;
+      drawRow(pool[k], index);
+      return &pool[k];
+    }
+  }
+  return nullptr;
+}
+
+// Blit the visible rows into the canvas under a viewport clip
+static void compose(void) {
+  int s = (int)scroll;
+  target->setClipRect(vx, vy, vw, vh);
+  for (int i = s / rowH; i < count && i * rowH - s < vh; i++) {
+    LGFX_Sprite *row = rowSprite(i);
+    if (row)
+      row->pushSprite(target, vx, vy + i * rowH - s);
+  }
+  int end = count * rowH - s;
+  if (end < vh)
+    target->fillRect(vx, vy + end, vw, vh - end, bgColor);
+
+  int total = count * rowH;
+  if (total > vh) {
+    int th = vh * vh / total;
+    if (th < 16)
+      th = 16;
+    int ty = vy + (vh - th) * s / maxScroll();
+    target->fillRect(vx + vw - LIST_THUMB_W, ty, LIST_THUMB_W, th,
+                     thumbColor);
+  }
+  target->clearClipRect();
+  dirtyAdd(vx, vy, vw, vh);
+}
+
+// ============================================================
+void listBegin(int x, int y, int w, int h, int rh, int n, ListRowDraw draw,
+               ListRowTap onTap, int scrollY) {
+  if (!target)
+    return;
+  if (h / rh + 2 > LIST_POOL)
+    Serial.printf("[List] %d px rows need more than %d sprites\n", rh,
+                  LIST_POOL);
+  if (w != poolW || rh != poolH) {
+    for (int k = 0; k < LIST_POOL; k++) {
+      pool[k].createSprite(w, rh);
+      // Same indices as the canvas, so rows blit without conversion
+      if (rowPalette)
+        pool[k].createPalette(rowPalette, rowPaletteCount);
+    }
+    poolW = w;
+    poolH = rh;
+  }
+  for (int k = 0; k < LIST_POOL; k++)
+    poolItem[k] = -1;
+
+  vx = x;
+  vy = y;
+  vw = w;
+  vh = h;
+  rowH = rh;
+  count = n;
+  drawRow = draw;
+  tapRow = onTap;
+  scroll = scrollY;
+  velocity = 0;
+  dragging = false;
+  clampScroll();
+  active = true;
+  compose();
+}
+
+void listEnd(void) {
+  active = false;
+  dragging = false;
+  velocity = 0;
+}
+
+bool listActive(void) { return active; }
+int listScrollY(void) { return (int)scroll; }
+
+// ============================================================
+// Input
+// ============================================================
+static bool inside(int x, int y) {
+  return x >= vx && x < vx + vw && y >= vy && y < vy + vh;
+}
+
+void listFeed(const TouchEvent &ev) {
+  if (!active)
+    return;
+  switch (ev.phase) {
+  case TOUCH_PRESS:
+    if (!inside(ev.x, ev.y))
+      break;
+    dragging = true;
+    stoppedFling = fabsf(velocity) >= LIST_MIN_SPEED;
+    velocity = 0;
+    lastY = ev.y;
+    lastMoveMs = ev.timeMs;
+    break;
+
+  case TOUCH_MOVE: {
+    if (!dragging)
+      break;
+    int dy = ev.y - lastY;
+    uint32_t dt = ev.timeMs - lastMoveMs;
+    scroll -= dy;
+    if (dt > 0)
+      velocity = 0.6f * (-(float)dy / dt) + 0.4f * velocity;
+    lastY = ev.y;
+    lastMoveMs = ev.timeMs;
+    clampScroll();
+    needsCompose = true;
+    break;
+  }
+
+  case TOUCH_RELEASE:
+    if (!dragging)
+      break;
+    dragging = false;
+    if (ev.timeMs - lastMoveMs > 80)
+      velocity = 0; // finger rested before lifting: no fling
+    break;
+  }
+}
+
+bool listTap(int x, int y) {
+  if (!active || !inside(x, y))
+    return false;
+  if (stoppedFling)
+    return true; // the press only caught the fling
+  int index = ((int)scroll + y - vy) / rowH;
+  if (index < count && tapRow)
+    tapRow(index);
+  return true;
+}
+
+// ============================================================
+// Momentum
+// ============================================================
+void listLoop(void) {
+  uint32_t now = millis();
+  uint32_t dt = now - lastFrameMs;
+  if (!active || dt < ANIM_FRAME_MS)
+    return;
+  lastFrameMs = now;
+  if (dt > 100)
+    dt = 100; // resuming after a blocking call — don't jump
+
+  if (!dragging && velocity != 0) {
+    scroll += velocity * dt;
+    velocity *= powf(LIST_FRICTION, dt / 16.0f);
+    if (fabsf(velocity) < LIST_MIN_SPEED)
+      velocity = 0;
+    clampScroll();
+    needsCompose = true;
+  }
+  if (needsCompose) {
+    needsCompose = false;
+    compose();
+  }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "config.h"
+#include "touch_input.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// Virtualized kinetic scroll list (one per screen)
+// Only the rows inside the viewport are rendered, into a fixed pool of
+// row sprites that is recycled as rows scroll in and out — memory does
+// not grow with the item count. Flings decay with friction and are
+// stepped once per ANIM_FRAME_MS.
+// ============================================================
+#define LIST_POOL 6          // row sprites: enough for ceil(h/rowH) + 1
+#define LIST_FRICTION 0.95f  // velocity kept per 16 ms
+#define LIST_MIN_SPEED 0.02f // px/ms below which a fling stops
+#define LIST_THUMB_W 4       // scroll indicator width
+
+// Draws item `index` into a rowH-high sprite at (0,0); must paint the
+// whole row including its background.
+typedef void (*ListRowDraw)(LGFX_Sprite &row, int index);
+typedef void (*ListRowTap)(int index);
+
+// --- Lifecycle ---
+// `palette` is shared with the canvas when it is palette-indexed
+void listSetup(LGFX_Sprite &canvas, uint16_t bg, uint16_t thumb,
+               const uint16_t *palette = nullptr, int paletteCount = 0);
+void listBegin(int x, int y, int w, int h, int rowH, int count,
+               ListRowDraw draw, ListRowTap onTap, int scrollY = 0);
+void listEnd(void); // called on screen switch
+bool listActive(void);
+int listScrollY(void);
+
+// --- Input ---
+void listFeed(const TouchEvent &ev); // drag + release velocity
+bool listTap(int x, int y);          // true if (x,y) was inside the list
+
+// --- Frame ---
+void listLoop(void); // momentum step + recompose when the offset changed
@@ -54,28 +54,57 @@ void servoSetup(void) {
 static bool manualServoState[NUM_MODULES] = {false};
 
 // ============================================================
+// Auto dispense sequence — out, return, release; advanced by servoLoop()
+// ============================================================
+#define DISPENSE_OUT_MS 800
+#define DISPENSE_RETURN_MS 500
+
+enum DispenseStep { STEP_IDLE, STEP_OUT, STEP_RETURN };
+static DispenseStep dispenseStep = STEP_IDLE;
+static int dispenseModule = 0;
+static unsigned long stepStartMs = 0;
+
 void servoDispense(int moduleIndex) {
   if (!pcaFound) {
     Serial.println("[Servo] PCA9685 not available");
     return;
   }
+  if (dispenseStep != STEP_IDLE) {
+    Serial.println("[Servo] Busy — dispense ignored");
+    return;
+  }
 
   int ch = moduleIndex % 16;
   Serial.printf("[Servo] Dispensing module=%d ch=%d\n", moduleIndex, ch);
 
-  // Auto dispense sequence
   pca9685.setPWM(ch, 0, angleToPulse(SERVO_ANGLE_DISP));
-  delay(800);
+  dispenseModule = moduleIndex;
+  dispenseStep = STEP_OUT;
+  stepStartMs = millis();
+}
 
-  pca9685.setPWM(ch, 0, angleToPulse(SERVO_ANGLE_HOME));
-  delay(500);
+void servoLoop(void) {
+  if (dispenseStep == STEP_IDLE)
+    return;
+
+  int ch = dispenseModule % 16;
+  unsigned long elapsed = millis() - stepStartMs;
 
-  pca9685.setPWM(ch, 0, 0);
-  manualServoState[moduleIndex] =
-      false; // Reset toggle state if it was moved automatically
-  Serial.println("[Servo] Done");
+  if (dispenseStep == STEP_OUT && elapsed >= DISPENSE_OUT_MS) {
+    pca9685.setPWM(ch, 0, angleToPulse(SERVO_ANGLE_HOME));
+    dispenseStep = STEP_RETURN;
+    stepStartMs = millis();
+  } else if (dispenseStep == STEP_RETURN && elapsed >= DISPENSE_RETURN_MS) {
+    pca9685.setPWM(ch, 0, 0);
+    manualServoState[dispenseModule] =
+        false; // Reset toggle state if it was moved automatically
+    dispenseStep = STEP_IDLE;
+    Serial.println("[Servo] Done");
+  }
 }
 
+bool servoIsBusy(void) { return dispenseStep != STEP_IDLE; }
+
 // ============================================================
 void servoToggleManual(int moduleIndex) {
   if (!pcaFound) {
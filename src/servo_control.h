@@ -6,7 +6,9 @@
 // Servo Control via PCA9685
 // ============================================================
 void servoSetup(void);
-void servoDispense(int slot);
+void servoLoop(void);          // advances the auto-dispense sequence
+void servoDispense(int slot);  // starts the sequence, returns immediately
+bool servoIsBusy(void);
 void servoToggleManual(int moduleIndex);
 bool servoIsManualActive(int moduleIndex);
 void servoHome(void);
@@ -0,0 +1,211 @@
+#include "soft_shape.h"
+#include "pixel_kernels.h"
+
+// ============================================================
+// Corner masks
+// ============================================================
+#define SOFT_SS 4 // supersamples per axis for the sharp edge
+#define SOFT_MAX_TILE (SOFT_MAX_RADIUS + 2 * SOFT_MAX_BLUR + 1)
+#define SOFT_GRID (SOFT_MAX_TILE + 2 * SOFT_MAX_BLUR)
+
+struct SoftMask {
+  uint8_t r, blur, tile; // tile = side of the corner square
+  uint8_t *cover;        // tile * tile, top-left corner, 0..255
+};
+
+static SoftMask masks[SOFT_MASK_SLOTS];
+static int maskCount = 0;
+static int maskVictim = 0; // round-robin once every slot is used
+
+// Samples (0..SOFT_SS^2) inside a rounded rect with its top-left at the
+// origin, for a pixel near that corner
+static uint8_t sharpCoverage(int px, int py, int r) {
+  if (px < 0 || py < 0)
+    return 0;
+  if (px >= r || py >= r)
+    return SOFT_SS * SOFT_SS;
+  uint8_t n = 0;
+  for (int j = 0; j < SOFT_SS; j++) {
+    for (int i = 0; i < SOFT_SS; i++) {
+      float dx = r - (px + (i + 0.5f) / SOFT_SS);
+      float dy = r - (py + (j + 0.5f) / SOFT_SS);
+      if (dx * dx + dy * dy <= (float)r * r)
+        n++;
+    }
+  }
+  return n;
+}
+
+// Tile pixel (i, j) is shape pixel (i - blur, j - blur): the sharp
+// coverage box-blurred over (2 * blur + 1)^2
+static bool buildMask(SoftMask &m, int r, int blur, int tile) {
+  m.cover = (uint8_t *)malloc(tile * tile);
+  if (!m.cover)
+    return false;
+  m.r = r;
+  m.blur = blur;
+  m.tile = tile;
+
+  static uint8_t sharp[SOFT_GRID * SOFT_GRID]; // shape coords from -2 * blur
+  int grid = tile + 2 * blur;
+  for (int j = 0; j < grid; j++)
+    for (int i = 0; i < grid; i++)
+      sharp[j * grid + i] = sharpCoverage(i - 2 * blur, j - 2 * blur, r);
+
+  int win = 2 * blur + 1;
+  uint32_t total = (uint32_t)win * win * SOFT_SS * SOFT_SS;
+  for (int j = 0; j < tile; j++) {
+    for (int i = 0; i < tile; i++) {
+      uint32_t sum = 0;
+      for (int v = 0; v < win; v++)
+        for (int u = 0; u < win; u++)
+          sum += sharp[(j + v) * grid + i + u];
+      m.cover[j * tile + i] = (uint8_t)((sum * 255 + total / 2) / total);
+    }
+  }
+  return true;
+}
+
+static const SoftMask *getMask(int r, int blur, int tile) {
+  for (int k = 0; k < maskCount; k++) {
+    const SoftMask &m = masks[k];
+    if (m.r == r && m.blur == blur && m.tile == tile)
+      return &m;
+  }
+  int slot = maskCount;
+  if (maskCount == SOFT_MASK_SLOTS) {
+    slot = maskVictim;
+    maskVictim = (maskVictim + 1) % SOFT_MASK_SLOTS;
+    free(masks[slot].cover);
+  }
+  if (!buildMask(masks[slot], r, blur, tile)) {
+    Serial.printf("[Soft] No memory for r=%d blur=%d mask\n", r, blur);
+    return nullptr;
+  }
+  if (slot == maskCount)
+    maskCount++;
+  Serial.printf("[Soft] Built %dx%d mask r=%d blur=%d\n", tile, tile, r,
+                blur);
+  return &masks[slot];
+}
+
+// Full corner tile, or half the blurred shape when that is smaller
+static int tileFor(int w, int h, int r, int blur) {
+  int full = r + 2 * blur + 1;
+  int half = ((w < h ? w : h) + 2 * blur) / 2;
+  return full < half ? full : half;
+}
+
+void softWarm(int r, int blur) {
+  if (r <= SOFT_MAX_RADIUS && blur <= SOFT_MAX_BLUR)
+    getMask(r, blur, r + 2 * blur + 1);
+}
+
+// ============================================================
+// Compositing — clipped spans through the pixel kernels
+// ============================================================
+struct SoftTarget {
+  uint16_t *buf;
+  int stride;
+  int x0, y0, x1, y1; // clip, exclusive right / bottom
+  uint16_t color;
+};
+
+static bool clipSpan(const SoftTarget &t, int &x, int y, int &n, int &skip) {
+  skip = 0;
+  if (y < t.y0 || y >= t.y1)
+    return false;
+  if (x < t.x0) {
+    skip = t.x0 - x;
+    n -= skip;
+    x = t.x0;
+  }
+  if (x + n > t.x1)
+    n = t.x1 - x;
+  return n > 0;
+}
+
+static void spanCover(const SoftTarget &t, int x, int y, int n,
+                      const uint8_t *cover) {
+  int skip;
+  if (clipSpan(t, x, y, n, skip))
+    pixBlendColor(t.buf + y * t.stride + x, t.color, cover + skip, n);
+}
+
+static void spanConst(const SoftTarget &t, int x, int y, int n, uint8_t c) {
+  static uint8_t row[LCD_WIDTH];
+  int skip;
+  if (c == 0 || !clipSpan(t, x, y, n, skip))
+    return;
+  if (c == 255) {
+    pixFill(t.buf + y * t.stride + x, t.color, n);
+  } else {
+    n = n < LCD_WIDTH ? n : LCD_WIDTH;
+    memset(row, c, n);
+    pixBlendColor(t.buf + y * t.stride + x, t.color, row, n);
+  }
+}
+
+// Composites `m` mirrored into the four corners of (ex, ey, ew, eh).
+// Rows between the corners reuse the tile's last row (the edge
+// profile), columns between them its last column.
+static void composite(const SoftTarget &t, int ex, int ey, int ew, int eh,
+                      const SoftMask &m) {
+  int T = m.tile;
+  uint8_t rev[SOFT_MAX_TILE];
+  for (int yy = 0; yy < eh; yy++) {
+    int y = ey + yy;
+    if (y < t.y0 || y >= t.y1)
+      continue;
+    int ty = yy < T ? yy : (yy >= eh - T ? eh - 1 - yy : T - 1);
+    const uint8_t *row = m.cover + ty * T;
+    for (int i = 0; i < T; i++)
+      rev[i] = row[T - 1 - i];
+    spanCover(t, ex, y, T, row);
+    spanConst(t, ex + T, y, ew - 2 * T, row[T - 1]);
+    spanCover(t, ex + ew - T, y, T, rev);
+  }
+}
+
+static bool target(LGFX_Sprite &dst, uint16_t color, SoftTarget &t) {
+  t.buf = (uint16_t *)dst.getBuffer();
+  if (!t.buf || dst.getColorDepth() != 16)
+    return false;
+  int32_t cx, cy, cw, ch;
+  dst.getClipRect(&cx, &cy, &cw, &ch);
+  t.stride = dst.width();
+  t.x0 = cx > 0 ? cx : 0;
+  t.y0 = cy > 0 ? cy : 0;
+  t.x1 = cx + cw < dst.width() ? cx + cw : dst.width();
+  t.y1 = cy + ch < dst.height() ? cy + ch : dst.height();
+  t.color = color;
+  return true;
+}
+
+// ============================================================
+void softRoundRect(LGFX_Sprite &dst, int x, int y, int w, int h, int r,
+                   uint16_t color) {
+  SoftTarget t;
+  const SoftMask *m = nullptr;
+  if (w > 0 && h > 0 && r <= SOFT_MAX_RADIUS && target(dst, color, t))
+    m = getMask(r, 0, tileFor(w, h, r, 0));
+  if (!m) {
+    dst.fillRoundRect(x, y, w, h, r, color);
+    return;
+  }
+  composite(t, x, y, w, h, *m);
+}
+
+void softShadow(LGFX_Sprite &dst, int x, int y, int w, int h, int r,
+                int blur, uint16_t color) {
+  SoftTarget t;
+  const SoftMask *m = nullptr;
+  if (w > 0 && h > 0 && r <= SOFT_MAX_RADIUS && blur <= SOFT_MAX_BLUR &&
+      target(dst, color, t))
+    m = getMask(r, blur, tileFor(w, h, r, blur));
+  if (!m) {
+    dst.fillRoundRect(x, y, w, h, r, color);
+    return;
+  }
+  composite(t, x - blur, y - blur, w + 2 * blur, h + 2 * blur, *m);
+}
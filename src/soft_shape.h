@@ -0,0 +1,29 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// Anti-aliased rounded rects and soft drop shadows
+// Coverage comes from precomputed corner masks keyed by radius, blur
+// and size class (the tile is clipped for shapes too small for a full
+// one). A mask is one corner, mirrored for the other three; its last
+// row doubles as the edge profile and the middle is a plain fill, so a
+// shape costs about what fillRoundRect does.
+// Masks are built once, at boot via softWarm() or on first use. On a
+// palette-indexed target there is nothing to blend with, so these fall
+// back to fillRoundRect.
+// ============================================================
+#define SOFT_MASK_SLOTS 12
+#define SOFT_MAX_RADIUS 24
+#define SOFT_MAX_BLUR 8
+
+// Filled rounded rect with anti-aliased corners
+void softRoundRect(LGFX_Sprite &dst, int x, int y, int w, int h, int r,
+                   uint16_t color);
+// Shadow of the rounded rect (x, y, w, h, r) blurred by `blur` px; it
+// spreads `blur` px past the rect on every side
+void softShadow(LGFX_Sprite &dst, int x, int y, int w, int h, int r,
+                int blur, uint16_t color);
+
+void softWarm(int r, int blur); // build the full-size mask up front
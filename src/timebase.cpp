@@ -0,0 +1,316 @@
+#include "timebase.h"
+#include "console.h"
+#include <RTClib.h>
+#include <Wire.h>
+#include <atomic>
+#include <esp_timer.h>
+
+static RTC_DS3231 rtc;
+static bool rtcFound = false;
+
+// Anchor: RTC second `baseEpoch` began at esp_timer `baseUs`
+static uint32_t baseEpoch = 0;
+static int64_t baseUs = 0;
+static int32_t driftPpb = 0; // esp_timer rate vs RTC, + = esp_timer fast
+static uint32_t lastEpoch = 0; // last value handed out
+static TimeAdjustCallback adjustCallback = nullptr;
+
+// Stats for `time`
+static uint32_t syncs = 0, syncFails = 0, rtcReads = 0;
+static int32_t lastErrUs = 0, maxErrUs = 0; // extrapolated - RTC
+
+#define NO_RTC_EPOCH 1767225600UL // 2026-01-01 00:00:00
+
+#if RTC_SQW_PIN >= 0
+static std::atomic<int64_t> sqwEdgeUs{0};
+static std::atomic<uint32_t> sqwEdges{0};
+
+static void IRAM_ATTR onSqwEdge() {
+  sqwEdgeUs.store(esp_timer_get_time(), std::memory_order_relaxed);
+  sqwEdges.fetch_add(1, std::memory_order_release);
+}
+#endif
+
+// ============================================================
+// Extrapolation
+// ============================================================
+// Microseconds of RTC time since the anchor at esp_timer `t`
+static int64_t rtcElapsedUs(int64_t t) {
+  int64_t raw = t - baseUs;
+  return raw - raw * driftPpb / 1000000000LL;
+}
+
+uint32_t timeEpoch(void) {
+  uint32_t e =
+      baseEpoch + (uint32_t)(rtcElapsedUs(esp_timer_get_time()) / 1000000);
+  if (e < lastEpoch)
+    return lastEpoch; // a resync stepped back across a second edge
+  lastEpoch = e;
+  return e;
+}
+
+int64_t timeEpochUs(uint32_t epoch) {
+  int64_t rtcUs = ((int64_t)epoch - baseEpoch) * 1000000;
+  return baseUs + rtcUs + rtcUs * driftPpb / 1000000000LL;
+}
+
+void timeOfDay(uint8_t &h, uint8_t &m, uint8_t &s) {
+  uint32_t day = timeEpoch() % 86400;
+  h = day / 3600;
+  m = (day / 60) % 60;
+  s = day % 60;
+}
+
+void timeDate(uint16_t &year, uint8_t &month, uint8_t &day, uint8_t &dow) {
+  DateTime now(timeEpoch());
+  year = now.year();
+  month = now.month();
+  day = now.day();
+  dow = now.dayOfTheWeek();
+}
+
+bool timeHasRTC(void) { return rtcFound; }
+void timeSetAdjustCallback(TimeAdjustCallback cb) { adjustCallback = cb; }
+
+// ============================================================
+// Second edges
+// Resyncing is a state machine advanced from timebaseLoop(), so the
+// loop never waits a second for the RTC:
+//   SYNC_SEEK  the anchor is a plain read (boot): the RTC is read once
+//              per loop until its seconds roll over. That places the
+//              edge to within a loop period, close enough for...
+//   SYNC_WAIT  the predicted edge: when it is TIMEBASE_EDGE_LEAD_MS
+//              away, a burst of reads at most TIMEBASE_BURST_MS long
+//              brackets it to about a millisecond.
+// With RTC_SQW_PIN wired both are replaced by the interrupt's stamp.
+// ============================================================
+enum SyncState : uint8_t { SYNC_IDLE, SYNC_SEEK, SYNC_WAIT };
+static SyncState syncState = SYNC_IDLE;
+static bool anchorFine = false; // anchor is a caught edge, not a read
+static int64_t nextSyncUs = 0;  // esp_timer time the next hunt starts
+static int64_t huntStartUs = 0;
+static uint32_t seekSecond;     // SYNC_SEEK: last RTC read...
+static int64_t seekReadUs;      // ...and when
+#if RTC_SQW_PIN >= 0
+static uint32_t sqwSeen; // edge count when the hunt started
+#endif
+
+static uint32_t readRtc(void) {
+  rtcReads++;
+  return rtc.now().unixtime();
+}
+
+// esp_timer time of the next predicted second edge
+static int64_t nextEdgeUs(void) {
+  uint32_t e =
+      baseEpoch + (uint32_t)(rtcElapsedUs(esp_timer_get_time()) / 1000000);
+  return timeEpochUs(e + 1);
+}
+
+// RTC second `epoch` began at `edgeUs`; `fine` when that is known to
+// about a millisecond
+static void anchor(uint32_t epoch, int64_t edgeUs, bool fine) {
+  int64_t rtcUs = (int64_t)(epoch - baseEpoch) * 1000000;
+  int64_t errUs = rtcElapsedUs(edgeUs) - rtcUs;
+  if (errUs > 2000000 || errUs < -2000000) {
+    // The RTC was set, or the anchor was never good: start over
+    Serial.printf("[Time] Off by %lld ms, re-anchored\n",
+                  (long long)(errUs / 1000));
+    lastEpoch = 0; // may go back
+  } else if (fine && anchorFine && rtcUs >= 60000000) {
+    // Rate of the last interval, smoothed; short intervals and coarse
+    // anchors are not precise enough to measure ppb over
+    int64_t rawUs = edgeUs - baseUs;
+    int32_t ppb = (int32_t)((rawUs - rtcUs) * 1000000000LL / rtcUs);
+    driftPpb = syncs ? (3 * driftPpb + ppb) / 4 : ppb;
+    lastErrUs = (int32_t)errUs;
+    int32_t mag = lastErrUs < 0 ? -lastErrUs : lastErrUs;
+    maxErrUs = mag > maxErrUs ? mag : maxErrUs;
+    syncs++;
+  }
+  baseEpoch = epoch;
+  baseUs = edgeUs;
+  anchorFine = fine;
+  if (fine) {
+    syncState = SYNC_IDLE;
+    nextSyncUs = edgeUs + (int64_t)TIMEBASE_RESYNC_MS * 1000;
+  } else {
+    syncState = SYNC_WAIT; // now close enough to catch it finely
+  }
+  if (adjustCallback)
+    adjustCallback();
+}
+
+static void startHunt(int64_t now) {
+  huntStartUs = now;
+#if RTC_SQW_PIN >= 0
+  sqwSeen = sqwEdges.load(std::memory_order_acquire);
+  syncState = SYNC_WAIT;
+#else
+  if (anchorFine) {
+    syncState = SYNC_WAIT;
+  } else {
+    syncState = SYNC_SEEK;
+    seekSecond = readRtc();
+    seekReadUs = esp_timer_get_time();
+  }
+#endif
+}
+
+// Gives up after TIMEBASE_HUNT_MAX_MS, keeping the old anchor. A coarse
+// anchor (the boot read) may be most of a second late, so that is
+// retried after TIMEBASE_RETRY_MS rather than a full resync interval.
+static bool huntExpired(int64_t now) {
+  if (now - huntStartUs < (int64_t)TIMEBASE_HUNT_MAX_MS * 1000)
+    return false;
+  syncFails++;
+  syncState = SYNC_IDLE;
+  uint32_t waitMs = anchorFine ? TIMEBASE_RESYNC_MS : TIMEBASE_RETRY_MS;
+  nextSyncUs = now + (int64_t)waitMs * 1000;
+  Serial.printf("[Time] RTC second edge not seen, retry in %lu s\n",
+                (unsigned long)(waitMs / 1000));
+  return true;
+}
+
+#if RTC_SQW_PIN >= 0
+static void huntStep(int64_t now) {
+  if (sqwEdges.load(std::memory_order_acquire) != sqwSeen) {
+    int64_t edgeUs = sqwEdgeUs.load(std::memory_order_relaxed);
+    anchor(readRtc(), edgeUs, true);
+    return;
+  }
+  huntExpired(now);
+}
+#else
+static void huntStep(int64_t now) {
+  if (syncState == SYNC_SEEK) {
+    uint32_t e = readRtc();
+    int64_t t = esp_timer_get_time();
+    int64_t bracketUs = t - seekReadUs;
+    bool rolled = e != seekSecond;
+    seekSecond = e;
+    seekReadUs = t;
+    // A slow loop brackets the edge too loosely to predict the next one
+    if (!rolled || bracketUs > TIMEBASE_EDGE_LEAD_MS * 1000) {
+      huntExpired(t);
+      return;
+    }
+    anchor(e, t - bracketUs / 2, bracketUs <= TIMEBASE_EDGE_FINE_US);
+    return;
+  }
+
+  // SYNC_WAIT: nothing to do until the predicted edge is close; a loop
+  // that arrives after it tries again a second later
+  if (nextEdgeUs() - now > TIMEBASE_EDGE_LEAD_MS * 1000) {
+    huntExpired(now);
+    return;
+  }
+  uint32_t first = readRtc();
+  int64_t prevUs = esp_timer_get_time();
+  while (prevUs - now < (int64_t)TIMEBASE_BURST_MS * 1000) {
+    delayMicroseconds(500);
+    uint32_t e = readRtc();
+    int64_t t = esp_timer_get_time();
+    if (e != first) {
+      anchor(e, (prevUs + t) / 2, t - prevUs <= TIMEBASE_EDGE_FINE_US);
+      return;
+    }
+    prevUs = t;
+  }
+  huntExpired(prevUs);
+}
+#endif
+
+// ============================================================
+// Setup / Loop
+// ============================================================
+static void timeCommand(const char *args);
+
+void timebaseSetup(void) {
+  if (rtc.begin()) {
+    rtcFound = true;
+    if (rtc.lostPower()) {
+      Serial.println("[RTC] Lost power — setting to compile time");
+      rtc.adjust(DateTime(F(__DATE__), F(__TIME__)));
+    }
+#if RTC_SQW_PIN >= 0
+    rtc.writeSqwPinMode(DS3231_SquareWave1Hz);
+    pinMode(RTC_SQW_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(RTC_SQW_PIN), onSqwEdge, FALLING);
+#endif
+    // Somewhere inside this second; the first loops find the edge
+    baseEpoch = readRtc();
+    baseUs = esp_timer_get_time();
+    nextSyncUs = baseUs;
+    DateTime now(baseEpoch);
+    Serial.printf("[RTC] OK — %04d-%02d-%02d %02d:%02d:%02d\n", now.year(),
+                  now.month(), now.day(), now.hour(), now.minute(),
+                  now.second());
+  } else {
+    Serial.println("[RTC] Not found — clock starts at 2026-01-01 00:00");
+    baseEpoch = NO_RTC_EPOCH;
+    baseUs = esp_timer_get_time();
+  }
+  consoleRegister("time", timeCommand,
+                  "[sync] clock, RTC drift and reads; resync now");
+}
+
+void timebaseLoop(void) {
+  if (!rtcFound)
+    return;
+  int64_t now = esp_timer_get_time();
+  if (syncState == SYNC_IDLE) {
+    if (now < nextSyncUs)
+      return;
+    startHunt(now);
+  }
+  huntStep(now);
+}
+
+int64_t timebaseWakeUs(void) {
+  if (!rtcFound)
+    return -1;
+  switch (syncState) {
+  case SYNC_IDLE:
+    return nextSyncUs;
+  case SYNC_SEEK:
+    return esp_timer_get_time() + TIMEBASE_SEEK_US;
+  default:
+#if RTC_SQW_PIN >= 0
+    // The SQW interrupt does not wake light sleep: be up just after
+    return nextEdgeUs() + TIMEBASE_SEEK_US;
+#else
+    return nextEdgeUs() - TIMEBASE_EDGE_LEAD_MS * 1000;
+#endif
+  }
+}
+
+// ============================================================
+// `time` — extrapolated clock against the RTC
+// ============================================================
+static void timeCommand(const char *args) {
+  if (strcmp(args, "sync") == 0) {
+    if (rtcFound && syncState == SYNC_IDLE) {
+      nextSyncUs = 0; // from the next loop; `time` again for the result
+      Serial.println("[Time] Resync started");
+    }
+  } else if (*args) {
+    Serial.println("usage: time [sync]");
+    return;
+  }
+  uint16_t yr;
+  uint8_t mo, dy, dow, h, m, s;
+  timeDate(yr, mo, dy, dow);
+  timeOfDay(h, m, s);
+  Serial.printf("[Time] %04d-%02d-%02d %02d:%02d:%02d%s\n", yr, mo, dy, h, m,
+                s, rtcFound ? "" : " (no RTC)");
+  if (!rtcFound)
+    return;
+  Serial.printf("  anchored %lld s ago, drift %+ld ppb\n",
+                (long long)((esp_timer_get_time() - baseUs) / 1000000),
+                (long)driftPpb);
+  Serial.printf("  resyncs %lu (%lu failed), error last %+ld us, max %ld us\n",
+                (unsigned long)syncs, (unsigned long)syncFails,
+                (long)lastErrUs, (long)maxErrUs);
+  Serial.printf("  RTC reads %lu\n", (unsigned long)rtcReads);
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Timebase
+// The DS3231 is read at boot and the wall clock is then extrapolated
+// from esp_timer — the getters below cost no I2C. The first loops after
+// boot, and then every TIMEBASE_RESYNC_MS, catch a second edge (a short
+// burst of reads just before it is due, or the 1 Hz SQW interrupt when
+// RTC_SQW_PIN is wired) without holding the loop for more than
+// TIMEBASE_BURST_MS; the difference to the extrapolation is the
+// measured drift, which corrects the rate until the next resync.
+// Without an RTC the clock starts at 2026-01-01 00:00 on boot.
+// Returned seconds never go backwards.
+// ============================================================
+void timebaseSetup(void); // finds the RTC, anchors; registers `time`
+void timebaseLoop(void);  // advances a resync when one is due
+// esp_timer time timebaseLoop() next needs to run (idle sleep ends by
+// then), -1 = never
+int64_t timebaseWakeUs(void);
+
+uint32_t timeEpoch(void); // Unix seconds
+int64_t timeEpochUs(uint32_t epoch); // esp_timer time that second begins
+void timeOfDay(uint8_t &h, uint8_t &m, uint8_t &s);
+void timeDate(uint16_t &year, uint8_t &month, uint8_t &day, uint8_t &dow);
+bool timeHasRTC(void);
+
+// Called after every resync: deadlines from timeEpochUs() may have moved
+typedef void (*TimeAdjustCallback)(void);
+void timeSetAdjustCallback(TimeAdjustCallback cb);
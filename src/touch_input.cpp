@@ -0,0 +1,118 @@
+#include "touch_input.h"
+#include "display_module.h"
+#include <atomic>
+#include <driver/gpio.h>
+#include <esp_sleep.h>
+
+// ============================================================
+// ISR → main: INT edge timestamps (single producer, single consumer)
+// ============================================================
+#define EDGE_QUEUE 8 // power of two
+
+static volatile uint32_t edgeStamps[EDGE_QUEUE];
+static std::atomic<uint8_t> edgeHead{0}; // written by ISR only
+static std::atomic<uint8_t> edgeTail{0}; // written by main loop only
+
+static void IRAM_ATTR onTouchInt(void) {
+  uint8_t head = edgeHead.load(std::memory_order_relaxed);
+  if ((uint8_t)(head - edgeTail.load(std::memory_order_acquire)) >=
+      EDGE_QUEUE)
+    return; // full — the main loop is already behind, drop the edge
+  edgeStamps[head % EDGE_QUEUE] = millis();
+  edgeHead.store(head + 1, std::memory_order_release);
+}
+
+// Drain all pending edges; returns true and the oldest stamp if any
+static bool takeEdges(uint32_t &firstStamp) {
+  uint8_t tail = edgeTail.load(std::memory_order_relaxed);
+  uint8_t head = edgeHead.load(std::memory_order_acquire);
+  if (tail == head)
+    return false;
+  firstStamp = edgeStamps[tail % EDGE_QUEUE];
+  edgeTail.store(head, std::memory_order_release);
+  return true;
+}
+
+// ============================================================
+// Touch event queue (main loop only)
+// ============================================================
+static TouchEvent events[TOUCH_EVENT_QUEUE];
+static uint8_t evHead = 0, evTail = 0;
+
+static void pushEvent(TouchPhase phase, int x, int y, uint32_t t) {
+  if ((uint8_t)(evHead - evTail) >= TOUCH_EVENT_QUEUE)
+    evTail++; // overwrite the oldest
+  events[evHead % TOUCH_EVENT_QUEUE] = {phase, (int16_t)x, (int16_t)y, t};
+  evHead++;
+}
+
+bool touchNext(TouchEvent &ev) {
+  if (evTail == evHead)
+    return false;
+  ev = events[evTail % TOUCH_EVENT_QUEUE];
+  evTail++;
+  return true;
+}
+
+// ============================================================
+// Finger tracking
+// ============================================================
+static bool fingerDown = false;
+static int16_t lastX = 0, lastY = 0;
+static unsigned long lastSampleMs = 0;
+
+bool touchIsDown(void) { return fingerDown; }
+
+void touchSetup(void) {
+  pinMode(CTP_INT_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(CTP_INT_PIN), onTouchInt, FALLING);
+  Serial.printf("[Touch] INT on GPIO %d\n", CTP_INT_PIN);
+}
+
+static bool wakeEdge = false; // light sleep ended on INT
+
+void touchWakeArm(void) {
+  gpio_wakeup_enable((gpio_num_t)CTP_INT_PIN, GPIO_INTR_LOW_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+}
+
+void touchWakeDisarm(bool woke) {
+  gpio_wakeup_disable((gpio_num_t)CTP_INT_PIN);
+  gpio_set_intr_type((gpio_num_t)CTP_INT_PIN, GPIO_INTR_NEGEDGE);
+  wakeEdge = woke;
+}
+
+void touchLoop(void) {
+  uint32_t edgeMs = 0;
+  bool edge = takeEdges(edgeMs);
+  if (wakeEdge && !edge) {
+    edge = true;
+    edgeMs = millis();
+  }
+  wakeEdge = false;
+
+  // Idle: no I2C traffic until the controller pulls INT low
+  if (!edge && !fingerDown)
+    return;
+  if (!edge && millis() - lastSampleMs < TOUCH_SAMPLE_MS)
+    return;
+  lastSampleMs = millis();
+
+  lgfx::touch_point_t tp;
+  if (getDisplay().getTouch(&tp)) {
+    if (!fingerDown) {
+      fingerDown = true;
+      pushEvent(TOUCH_PRESS, tp.x, tp.y, edge ? edgeMs : lastSampleMs);
+    } else if (abs(tp.x - lastX) >= TOUCH_MOVE_MIN_PX ||
+               abs(tp.y - lastY) >= TOUCH_MOVE_MIN_PX) {
+      pushEvent(TOUCH_MOVE, tp.x, tp.y, lastSampleMs);
+    } else {
+      return;
+    }
+    lastX = tp.x;
+    lastY = tp.y;
+  } else if (fingerDown) {
+    fingerDown = false;
+    pushEvent(TOUCH_RELEASE, lastX, lastY, lastSampleMs);
+  }
+}
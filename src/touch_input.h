@@ -0,0 +1,32 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Interrupt-driven touch input (FT6236 INT on CTP_INT_PIN)
+// The ISR only timestamps INT edges into a lock-free ring; the FT6236
+// is read over I2C only after an edge or while a finger is down.
+// ============================================================
+#define TOUCH_EVENT_QUEUE 16 // power of two
+#define TOUCH_SAMPLE_MS 16   // I2C sample period while a finger is down
+#define TOUCH_MOVE_MIN_PX 3  // movement below this is not reported
+
+enum TouchPhase : uint8_t { TOUCH_PRESS, TOUCH_MOVE, TOUCH_RELEASE };
+
+struct TouchEvent {
+  TouchPhase phase;
+  int16_t x, y;
+  uint32_t timeMs; // INT edge time for PRESS, sample time otherwise
+};
+
+void touchSetup(void);
+void touchLoop(void);
+bool touchNext(TouchEvent &ev); // pop the oldest event, false if empty
+bool touchIsDown(void);
+
+// --- Light sleep ---
+// While armed, INT low wakes the CPU. Edge interrupts are not latched in
+// light sleep, so disarming with woke = true makes the next touchLoop()
+// sample the controller as if the edge had been seen.
+void touchWakeArm(void);
+void touchWakeDisarm(bool woke);
@@ -1,72 +1,146 @@
 #include "ui_manager.h"
+#include "anim.h"
+#include "asset_data.h"
+#include "console.h"
 #include "config.h"
+#include "dirty_rect.h"
+#include "display_list.h"
 #include "display_module.h"
+#include "font_data.h"
+#include "gesture.h"
+#include "glyph_cache.h"
+#include "layer_cache.h"
+#include "power.h"
+#include "profiler.h"
 #include "scheduler.h"
+#include "scroll_list.h"
 #include "servo_control.h"
+#include "touch_input.h"
+#include "ui_strings.h"
+#include "widget.h"
 #include "wifi_manager.h"
+#include <Preferences.h>
 #include <WiFi.h>
 
 // ============================================================
 // Color Palette — Light Mint "Production" Theme
+// With a palette-indexed canvas (UI_CANVAS_BPP 4 / 8) COL_* are indices
+// into uiPalette; the RGB565 values are applied when the frame is pushed.
 // ============================================================
-#define COL_BG       0xF7DE // Very light mint background
-#define COL_CARD     0xFFFF // Clean white for cards
-#define COL_PRIMARY  0x2652 // Teal/Mint (#20C997)
-#define COL_ACCENT   0x15D0 // Darker teal (#12B886)
-#define COL_SUCCESS  0x460A // Green (#40C057)
-#define COL_DANGER   0xFA8A // Red (#FA5252)
-#define COL_WARN     0xFC62 // Orange
-#define COL_TEXT     0x31C8 // Main texts (#343A40)
-#define COL_TEXT_INV 0xFFFF // White text (for buttons/headers)
-#define COL_TEXT_DIM 0x8472 // Light gray for secondary text (#868E96)
-#define COL_BTN      0xEF7D // Default button bg (#E9ECEF)
-#define COL_BTN_ON   0x2652 // Active toggle
-#define COL_DIVIDER  0xDF1C // Subtle divider lines (#DEE2E6)
-#define COL_SHADOW   0xCE59 // Button shadow (#CED4DA)
+#define RGB_BG       0xF7DE // Very light mint background
+#define RGB_CARD     0xFFFF // Clean white for cards
+#define RGB_PRIMARY  0x2652 // Teal/Mint (#20C997)
+#define RGB_ACCENT   0x15D0 // Darker teal (#12B886)
+#define RGB_SUCCESS  0x460A // Green (#40C057)
+#define RGB_DANGER   0xFA8A // Red (#FA5252)
+#define RGB_WARN     0xFC62 // Orange
+#define RGB_TEXT     0x31C8 // Main texts (#343A40)
+#define RGB_TEXT_INV 0xFFFF // White text (for buttons/headers)
+#define RGB_TEXT_DIM 0x8472 // Light gray for secondary text (#868E96)
+#define RGB_BTN      0xEF7D // Default button bg (#E9ECEF)
+#define RGB_BTN_ON   0x2652 // Active toggle
+#define RGB_DIVIDER  0xDF1C // Subtle divider lines (#DEE2E6)
+#define RGB_SHADOW   0xCE59 // Button shadow (#CED4DA)
+
+#if UI_CANVAS_BPP == 16
+#define COL_BG       RGB_BG
+#define COL_CARD     RGB_CARD
+#define COL_PRIMARY  RGB_PRIMARY
+#define COL_ACCENT   RGB_ACCENT
+#define COL_SUCCESS  RGB_SUCCESS
+#define COL_DANGER   RGB_DANGER
+#define COL_WARN     RGB_WARN
+#define COL_TEXT     RGB_TEXT
+#define COL_TEXT_INV RGB_TEXT_INV
+#define COL_TEXT_DIM RGB_TEXT_DIM
+#define COL_BTN      RGB_BTN
+#define COL_BTN_ON   RGB_BTN_ON
+#define COL_DIVIDER  RGB_DIVIDER
+#define COL_SHADOW   RGB_SHADOW
+#else
+enum : uint8_t {
+  COL_BG,
+  COL_CARD,
+  COL_PRIMARY,
+  COL_ACCENT,
+  COL_SUCCESS,
+  COL_DANGER,
+  COL_WARN,
+  COL_TEXT,
+  COL_TEXT_INV,
+  COL_TEXT_DIM,
+  COL_BTN,
+  COL_BTN_ON,
+  COL_DIVIDER,
+  COL_SHADOW,
+  COL_COUNT
+};
+static const uint16_t uiPalette[COL_COUNT] = {
+    RGB_BG, RGB_CARD, RGB_PRIMARY, RGB_ACCENT, RGB_SUCCESS, RGB_DANGER,
+    RGB_WARN, RGB_TEXT, RGB_TEXT_INV, RGB_TEXT_DIM, RGB_BTN, RGB_BTN_ON,
+    RGB_DIVIDER, RGB_SHADOW};
+#endif
 
 // ============================================================
 // ============================================================
-// Slot labels (English short)
+// Medicine icons
 // ============================================================
-static const char *slotShort[NUM_TIME_SLOTS] = {"M.Bf", "M.Af", "N.Bf", "N.Af",
-                                                "E.Bf", "E.Af", "Bed"};
-static const char *periodName[] = {"Morning", "Noon", "Evening", "Bedtime"};
+// One per medicine preset (ui_strings.h), in preset order
+static const Asset *const presetIcons[NUM_PRESETS] = {
+    &ICON_PILL_GENERIC, &ICON_PILL_GENERIC, &ICON_PILL_GENERIC,
+    &ICON_PILL_GENERIC, &ICON_PILL_GENERIC, &ICON_PILL_GENERIC,
+    &ICON_PILL_TABLET,  &ICON_PILL_VITAMIN, &ICON_PILL_TABLET,
+    &ICON_PILL_SYRUP,   &ICON_PILL_CAPSULE, &ICON_PILL_CAPSULE,
+    &ICON_PILL_TABLET,  &ICON_PILL_CAPSULE};
+
+static const Asset &moduleIcon(const char *name) {
+  int i = langPresetFind(name);
+  return i >= 0 ? *presetIcons[i] : ICON_PILL_GENERIC;
+}
 
-// Preset medicine names
-static const char *presetNames[] = {
-    "Slot 1",  "Slot 2",      "Slot 3",    "Slot 4",    "Slot 5",
-    "Slot 6",  "Paracetamol", "Vitamin C", "Antacid",   "Cough Med",
-    "Allergy", "Antibiotic",  "Ibuprofen", "Omeprazole"};
-static const int numPresets = sizeof(presetNames) / sizeof(presetNames[0]);
+// Profiler labels, indexed by Screen
+static const char *screenNames[SCREEN_COUNT] = {
+    "draw home",   "draw sched",  "draw picker", "draw modules",
+    "draw detail", "draw manual", "draw confirm", "draw wifi",
+    "draw scan",   "draw osk",    "draw portal", "draw dispense",
+    "draw result"};
 
 // ============================================================
 // State
 // ============================================================
 static Screen currentScreen = SCREEN_HOME;
 static unsigned long lastClockTick = 0;
-static unsigned long lastTouchMs = 0;
-#define DEBOUNCE 300
+static bool clockSeconds = true;     // clock drawn as HH:MM:SS
+static uint8_t lastClockMinute = 0xFF;
 
 static int editSlotIdx = -1;
 static int editModIdx = -1;
 static uint8_t editH = 8, editM = 0;
-static int modPage = 0;
+static int modScroll = 0; // module list offset, kept across detail visits
+
+static DirtySprite canvas;
+// Live regions as last drawn (home clock + "Next:" line, confirm
+// countdown); each tick records the new list and replays the difference
+static DisplayList homeLive, countdownLive, liveNext;
 
-static LGFX_Sprite canvas;
+// Gesture routing: the auto-repeat widget under the finger, and the
+// current screen's swipe handler (picker columns)
+typedef void (*SwipeHandler)(const Gesture &g);
+static int heldWidget = WIDGET_NONE;
+static SwipeHandler screenSwipe = nullptr;
 
 static ManualDispenseCallback manualCb = nullptr;
 void uiSetManualDispenseCallback(ManualDispenseCallback cb) { manualCb = cb; }
 
 static ConfirmDispenseCallback confirmCb = nullptr;
 static int confirmSlotIdx = -1;
+static uint8_t confirmH, confirmM; // when it was triggered
 static unsigned long confirmStartMs = 0;
 
 // ============================================================
 // WiFi UI State
 // ============================================================
-static int wifiScanCount = 0;
-static int wifiScanPage = 0;
-static String wifiNetworks[20];
+static int wifiScanCount = 0; // SSIDs are read from the scan lazily per row
 static bool wifiScanning = false;
 static bool wifiNeedsScan = false;
 static String selectedSSID = "";
@@ -92,78 +166,116 @@ static void drawWifiMenu();
 static void drawWifiOSK();
 static void drawWifiPortal();
 static void drawWifiScan();
-static void touchHome(int x, int y);
-static void touchSchedule(int x, int y);
-static void touchTimePicker(int x, int y);
-static void touchModules(int x, int y);
-static void touchModuleDetail(int x, int y);
-static void touchManualDispense(int x, int y);
-static void touchConfirmDispense(int x, int y);
-static void touchWifiMenu(int x, int y);
-static void touchWifiOSK(int x, int y);
-static void touchWifiPortal(int x, int y);
-static void touchWifiScan(int x, int y);
+static void drawDispensing();
+static void drawResult();
 static void switchTo(Screen s);
+static void renderScreen(Screen s);
+static void buildScreen(Screen s);
+static uint32_t screenVariant(Screen s);
+static void setLanguage(Lang lang);
+static void langCommand(const char *args);
+static void benchCommand(const char *args);
+static void goldenCommand(const char *args);
+static void transitionTo(Screen s);
+static void present();
+static void presentAndWait();
+static void drawHomeLive();
+static void drawConfirmCountdown();
+static void patchLive(DisplayList &shown, void (*draw)());
+static void handleGesture(const Gesture &g);
 static void btn(int x, int y, int w, int h, const char *txt, uint16_t bg,
                 uint16_t fg);
 
 void uiShowConfirmDispense(int timeSlotIndex) {
   confirmSlotIdx = timeSlotIndex;
+  uint8_t s;
+  schedulerGetTime(confirmH, confirmM, s);
   confirmStartMs = millis();
   switchTo(SCREEN_CONFIRM_DISPENSE);
 }
 
+bool uiConfirmPending(void) {
+  return currentScreen == SCREEN_CONFIRM_DISPENSE;
+}
+
 // ============================================================
 void uiSetup() {
-  canvas.setPsram(true);
-  canvas.setColorDepth(16);
-  canvas.createSprite(480, 320);
+  langSetup();
+  canvas.setColorDepth(UI_CANVAS_BPP);
+  displayFramesSetup(canvas);
+#if UI_CANVAS_BPP == 16
+  listSetup(canvas, COL_BG, COL_SHADOW);
+#else
+  canvas.createPalette(uiPalette, COL_COUNT);
+  displaySetPalette(uiPalette, COL_COUNT);
+  listSetup(canvas, COL_BG, COL_SHADOW, uiPalette, COL_COUNT);
+#endif
+  for (int i = 0; i < SCREEN_COUNT; i++)
+    profName(PROF_DRAW(i), screenNames[i]);
+
+#if UI_CANVAS_BPP == 16
+  // Clock and countdown digits are blitted from pinned glyph cells
+  glyphCacheSetup();
+  glyphWarm(FONT_CLOCK, "0123456789:", COL_TEXT, COL_BG);
+  glyphWarm(uiFont(FONT_BODY), "0123456789:", COL_DANGER, COL_BG);
+
+  // Card and button masks, so no screen builds one mid-frame
+  softWarm(8, 0);
+  softWarm(8, 3);
+  softWarm(6, 0);
+  softWarm(6, 2);
+#endif
+
+  consoleRegister("bench", benchCommand,
+                  "[n] full vs cached render time of every screen");
+  consoleRegister("golden", goldenCommand,
+                  "save|check static-layer hashes of every screen (NVS)");
+  consoleRegister(
+      "dlist",
+      [](const char *) {
+        dlDump(homeLive);
+        dlDump(countdownLive);
+      },
+      "dump the recorded live display lists (home, countdown)");
+  consoleRegister("lang", langCommand, "[en|th] show or switch UI language");
   switchTo(SCREEN_HOME);
 }
 
 // ============================================================
 // Main loop
 // ============================================================
+// Seconds only while someone is using the screen; idle, the clock turns
+// once a minute so the loop can sleep in between; asleep, not at all
+static bool clockDue(void) {
+  PowerState ps = powerState();
+  if (ps == POWER_SLEEP)
+    return false;
+  if ((ps == POWER_ACTIVE) != clockSeconds)
+    return true;
+  if (clockSeconds)
+    return millis() - lastClockTick >= 1000;
+  uint8_t h, m, s;
+  schedulerGetTime(h, m, s);
+  return m != lastClockMinute;
+}
+
 void uiLoop() {
-  LGFX &lcd = getDisplay();
+  // Tweens (dispensing dots, result badge, transitions)
+  animLoop();
+  listLoop();
+  present();
 
-  // Live clock on home screen
-  if (currentScreen == SCREEN_HOME && millis() - lastClockTick >= 1000) {
+  // Live clock on home screen — only changed glyph cells are redrawn
+  if (currentScreen == SCREEN_HOME && clockDue()) {
     lastClockTick = millis();
-    uint8_t h, m, s;
-    schedulerGetTime(h, m, s);
-
-    // Big time
-    char buf[9];
-    sprintf(buf, "%02d:%02d:%02d", h, m, s);
-    canvas.setFont(&fonts::FreeSansBold24pt7b);
-    canvas.setTextDatum(middle_center);
-    canvas.setTextColor(COL_TEXT, COL_BG);
-    canvas.fillRect(30, 68, 300, 55, COL_BG);
-    canvas.drawString(buf, 175, 95);
-
-    // Next schedule
-    canvas.setFont(&fonts::FreeSans12pt7b);
-    canvas.fillRect(30, 153, 300, 35, COL_BG);
-    canvas.setTextDatum(middle_center);
-    int next = schedulerNextSlot();
-    if (next >= 0) {
-      TimeSlot &ts = timeSlotGet(next);
-      char nb[40];
-      sprintf(nb, "Next: %s  %02d:%02d", slotShort[next], ts.hour, ts.minute);
-      canvas.setTextColor(COL_SUCCESS, COL_BG);
-      canvas.drawString(nb, 175, 172);
-    } else {
-      canvas.setTextColor(COL_TEXT_DIM, COL_BG);
-      canvas.drawString("No upcoming schedule", 175, 172);
-    }
-    canvas.pushSprite(&getDisplay(), 0, 0);
+    patchLive(homeLive, drawHomeLive);
+    present();
   }
 
   // Handle Captive Portal blocking wait
   if (currentScreen == SCREEN_WIFI_PORTAL && !portalActive) {
     portalActive = true;
-    canvas.pushSprite(&getDisplay(), 0, 0); // Show "look at phone" text
+    presentAndWait(); // Show "look at phone" text
     wifiStartPortal();
     portalActive = false;
     switchTo(SCREEN_HOME);
@@ -173,44 +285,13 @@ void uiLoop() {
   if (currentScreen == SCREEN_WIFI_SCAN && wifiNeedsScan) {
     wifiNeedsScan = false;
     wifiScanning = true;
-    drawWifiScan();
-    canvas.pushSprite(&getDisplay(), 0, 0);
+    switchTo(SCREEN_WIFI_SCAN); // "Scanning..."
+    presentAndWait();
 
     wifiScanCount = WiFi.scanNetworks();
-    if (wifiScanCount > 20)
-      wifiScanCount = 20;
-    for (int i = 0; i < wifiScanCount; i++) {
-      wifiNetworks[i] = WiFi.SSID(i);
-    }
+    if (wifiScanCount < 0)
+      wifiScanCount = 0;
     wifiScanning = false;
-    wifiScanPage = 0;
-    switchTo(SCREEN_WIFI_SCAN); // Redraw list
-  }
-
-  // Handle Captive Portal blocking wait
-  if (currentScreen == SCREEN_WIFI_PORTAL && !portalActive) {
-    portalActive = true;
-    canvas.pushSprite(&getDisplay(), 0, 0); // Show "look at phone" text
-    wifiStartPortal();
-    portalActive = false;
-    switchTo(SCREEN_HOME);
-  }
-
-  // Handle WiFi Scan
-  if (currentScreen == SCREEN_WIFI_SCAN && wifiNeedsScan) {
-    wifiNeedsScan = false;
-    wifiScanning = true;
-    drawWifiScan();
-    canvas.pushSprite(&getDisplay(), 0, 0);
-
-    wifiScanCount = WiFi.scanNetworks();
-    if (wifiScanCount > 20)
-      wifiScanCount = 20;
-    for (int i = 0; i < wifiScanCount; i++) {
-      wifiNetworks[i] = WiFi.SSID(i);
-    }
-    wifiScanning = false;
-    wifiScanPage = 0;
     switchTo(SCREEN_WIFI_SCAN); // Redraw list
   }
 
@@ -218,63 +299,177 @@ void uiLoop() {
   if (currentScreen == SCREEN_CONFIRM_DISPENSE) {
     if (millis() - confirmStartMs > 10 * 60 * 1000UL) {
       Serial.println("[UI] Dispense confirmation timed out");
-      switchTo(SCREEN_HOME);
+      transitionTo(SCREEN_HOME);
     } else if (millis() - lastClockTick >= 1000) {
       lastClockTick = millis();
-      switchTo(SCREEN_CONFIRM_DISPENSE); // Redraw countdown
+      patchLive(countdownLive, drawConfirmCountdown);
+      present();
     }
   }
 
-  // Touch
-  lgfx::touch_point_t tp;
-  if (lcd.getTouch(&tp)) {
-    if (millis() - lastTouchMs < DEBOUNCE)
-      return;
-    lastTouchMs = millis();
-    Serial.printf("[Touch] x=%d y=%d screen=%d\n", tp.x, tp.y, currentScreen);
-    switch (currentScreen) {
-    case SCREEN_HOME:
-      touchHome(tp.x, tp.y);
-      break;
-    case SCREEN_SCHEDULE:
-      touchSchedule(tp.x, tp.y);
-      break;
-    case SCREEN_TIME_PICKER:
-      touchTimePicker(tp.x, tp.y);
-      break;
-    case SCREEN_MODULES:
-      touchModules(tp.x, tp.y);
-      break;
-    case SCREEN_MODULE_DETAIL:
-      touchModuleDetail(tp.x, tp.y);
-      break;
-    case SCREEN_MANUAL_DISPENSE:
-      touchManualDispense(tp.x, tp.y);
-      break;
-    case SCREEN_CONFIRM_DISPENSE:
-      touchConfirmDispense(tp.x, tp.y);
-      break;
-    case SCREEN_WIFI_MENU:
-      touchWifiMenu(tp.x, tp.y);
-      break;
-    case SCREEN_WIFI_SCAN:
-      touchWifiScan(tp.x, tp.y);
-      break;
-    case SCREEN_WIFI_OSK:
-      touchWifiOSK(tp.x, tp.y);
-      break;
-    case SCREEN_WIFI_PORTAL:
-      touchWifiPortal(tp.x, tp.y);
+  // Touch — raw events feed the recognizer, gestures resolve through the
+  // screen's widget tree
+  TouchEvent ev;
+  while (touchNext(ev)) {
+    if (ev.phase == TOUCH_PRESS)
+      Serial.printf("[Touch] x=%d y=%d screen=%d (%lu ms)\n", ev.x, ev.y,
+                    currentScreen, millis() - ev.timeMs);
+    if (powerTouch(ev))
+      continue; // the touch that woke the screen
+    listFeed(ev);
+    gestureFeed(ev);
+  }
+  gestureLoop();
+  Gesture g;
+  while (gestureNext(g))
+    handleGesture(g);
+}
+
+// ============================================================
+// Gesture dispatch
+// Auto-repeat widgets fire on press and on every repeat; all other
+// widgets fire on tap (release), so a swipe that starts on a button
+// does not also press it.
+// ============================================================
+static void handleGesture(const Gesture &g) {
+  switch (g.type) {
+  case GESTURE_PRESS: {
+    int id = widgetHitTest(g.x, g.y);
+    heldWidget = WIDGET_NONE;
+    if (id != WIDGET_NONE && (widgetGet(id).flags & WIDGET_REPEAT)) {
+      heldWidget = id;
+      gestureArmRepeat();
+      widgetGet(id).onTap(id);
+      present();
+    }
+    break;
+  }
+  case GESTURE_REPEAT:
+    if (heldWidget != WIDGET_NONE) {
+      widgetGet(heldWidget).onTap(heldWidget);
+      present();
+    }
+    break;
+  case GESTURE_TAP: {
+    if (listTap(g.x, g.y)) {
+      present();
       break;
-    default:
+    }
+    int id = widgetHitTest(g.x, g.y);
+    if (id == WIDGET_NONE || (widgetGet(id).flags & WIDGET_REPEAT))
       break;
+    widgetDispatch(g.x, g.y);
+    present(); // Widgets repaint only themselves
+    break;
+  }
+  case GESTURE_SWIPE:
+    Serial.printf("[Gesture] swipe dir=%d %.2f px/ms%s\n", g.dir, g.speed,
+                  g.flick ? " (flick)" : "");
+    heldWidget = WIDGET_NONE;
+    if (screenSwipe) {
+      screenSwipe(g);
+      present();
     }
+    break;
   }
 }
 
+// ============================================================
+// Screen switching
 // ============================================================
 static void switchTo(Screen s) {
+  renderScreen(s);
+  present();
+}
+
+// Left-to-right wipe: the new screen is rendered without damage, then a
+// tween pushes it to the panel in vertical bands.
+static int wipeX = 0;
+
+static void onWipe(float value, int) {
+  int x = (int)value;
+  if (x > wipeX) {
+    dirtyAdd(wipeX, 0, x - wipeX, LCD_HEIGHT);
+    wipeX = x;
+  }
+}
+
+static void transitionTo(Screen s) {
+  displayWait(); // the outgoing frame must be fully on the panel
+  renderScreen(s);
+  dirtyClear();
+  wipeX = 0;
+  animTween(0, LCD_WIDTH, 250, EASE_OUT_QUAD, onWipe);
+}
+
+// Static layers: the first visit renders the screen twice — a static
+// pass whose frame is cached, then the dynamic sections on top. Later
+// visits with the same variant memcpy the layer back and only run the
+// dynamic pass.
+static uint32_t fullRenderUs[LAYER_SLOTS];
+static bool renderQuiet = false; // bench: no per-render log lines
+
+static void renderScreen(Screen s) {
   currentScreen = s;
+  animCancelAll();
+  uint32_t stamp = profStamp();
+  uint32_t variant = screenVariant(s);
+  bool cached = layerRestore(s, variant, canvas.getBuffer());
+  if (!cached) {
+    canvas.setLayerPass(PASS_STATIC);
+    buildScreen(s);
+    layerStore(s, variant, canvas.getBuffer());
+  }
+  canvas.setLayerPass(PASS_DYNAMIC);
+  buildScreen(s);
+  canvas.setLayerPass(PASS_FULL);
+  dirtyAddAll();
+
+  uint32_t us = profEnd(PROF_DRAW(s), stamp);
+  if (renderQuiet) {
+    if (!cached)
+      fullRenderUs[s] = us;
+  } else if (cached) {
+    Serial.printf("[UI] Screen %d rendered in %lu us (cached layer, full "
+                  "render %lu us)\n",
+                  s, (unsigned long)us, (unsigned long)fullRenderUs[s]);
+  } else {
+    fullRenderUs[s] = us;
+    Serial.printf("[UI] Screen %d rendered in %lu us (full)\n", s,
+                  (unsigned long)us);
+  }
+}
+
+// Runs a section whose pixels change between visits: left out of the
+// cached layer, drawn over it.
+template <typename Fn> static void dynamic(Fn fn) {
+  if (canvas.layerPass() == PASS_STATIC)
+    return;
+  canvas.dynamicBegin();
+  fn();
+  canvas.dynamicEnd();
+}
+
+// Live regions: drawn normally while recording the list that is on
+// screen, then patched from a fresh recording (display_list.h)
+static void showLive(DisplayList &shown, void (*draw)()) {
+  canvas.recordBegin(shown, true);
+  draw();
+  canvas.recordEnd();
+}
+
+static void patchLive(DisplayList &shown, void (*draw)()) {
+  canvas.recordBegin(liveNext, false);
+  draw();
+  canvas.recordEnd();
+  dlPatch(shown, liveNext, canvas);
+}
+
+static void buildScreen(Screen s) {
+  widgetsReset();
+  listEnd();
+  heldWidget = WIDGET_NONE;
+  screenSwipe = nullptr;
   canvas.fillScreen(COL_BG);
   switch (s) {
   case SCREEN_HOME:
@@ -310,129 +505,299 @@ static void switchTo(Screen s) {
   case SCREEN_WIFI_PORTAL:
     drawWifiPortal();
     break;
+  case SCREEN_DISPENSING:
+    drawDispensing();
+    break;
+  case SCREEN_RESULT:
+    drawResult();
+    break;
   default:
     break;
   }
-  canvas.pushSprite(&getDisplay(), 0, 0);
+}
+
+// ============================================================
+// Hand the damaged regions to the DMA pipeline (non-blocking)
+// ============================================================
+static void present() { displayPresent(canvas); }
+
+// Let the last frame finish streaming before a blocking call or a
+// direct-to-panel draw
+static void presentAndWait() {
+  displayWait(); // so present() isn't deferred
+  present();
+  displayWait();
 }
 
 // ============================================================
 // Button helper
 // ============================================================
-static void btn(int x, int y, int w, int h, const char *txt, uint16_t bg,
-                uint16_t fg) {
-  auto &lcd = canvas;
+// Drawn on the canvas, or into a scroll-list row sprite
+template <typename Gfx>
+static void btnOn(Gfx &lcd, int x, int y, int w, int h, const char *txt,
+                  uint16_t bg, uint16_t fg) {
   // Button shadow
   if (bg != COL_BG && bg != COL_CARD) {
-    lcd.fillRoundRect(x, y + 2, w, h, 6, COL_SHADOW);
+    softShadow(lcd, x, y + 2, w, h, 6, 2, COL_SHADOW);
   }
-  lcd.fillRoundRect(x, y, w, h, 6, bg);
+  softRoundRect(lcd, x, y, w, h, 6, bg);
   if (bg == COL_BTN) {
     lcd.drawRoundRect(x, y, w, h, 6, COL_DIVIDER);
   }
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(fg, bg);
   lcd.drawString(txt, x + w / 2, y + h / 2 - 1);
 }
 
+static void btn(int x, int y, int w, int h, const char *txt, uint16_t bg,
+                uint16_t fg) {
+  btnOn(canvas, x, y, w, h, txt, bg, fg);
+}
+
+// Button that also registers a tappable widget with the same bounds
+static int button(int x, int y, int w, int h, const char *txt, uint16_t bg,
+                  uint16_t fg, WidgetHandler onTap, int arg = 0,
+                  int parent = WIDGET_NONE) {
+  btn(x, y, w, h, txt, bg, fg);
+  return widgetAdd(x, y, w, h, onTap, arg, nullptr, parent);
+}
+
+// Clear a widget's area (plus the button shadow) before it repaints itself
+static void clearWidget(const Widget &w, uint16_t bg) {
+  canvas.fillRect(w.x, w.y, w.w, w.h + 2, bg);
+}
+
+// Standard header "Back" button
+static void backButton(WidgetHandler onTap) {
+  button(5, 5, 60, 30, tr(STR_BACK), COL_CARD, COL_TEXT, onTap);
+}
+
+template <typename Gfx>
+static void shadowCardOn(Gfx &lcd, int x, int y, int w, int h) {
+  softShadow(lcd, x, y + 3, w, h, 8, 3, COL_SHADOW);
+  softRoundRect(lcd, x, y, w, h, 8, COL_CARD);
+  // lcd.drawRoundRect(x, y, w, h, 8, COL_DIVIDER); // Optional subtle border
+}
+
 static void drawShadowCard(int x, int y, int w, int h) {
-  canvas.fillRoundRect(x, y+3, w, h, 8, COL_SHADOW);
-  canvas.fillRoundRect(x, y, w, h, 8, COL_CARD);
-  // canvas.drawRoundRect(x, y, w, h, 8, COL_DIVIDER); // Optional subtle border
+  shadowCardOn(canvas, x, y, w, h);
 }
 
 // ============================================================
 // HOME SCREEN
 // Layout: header(0-44), left-half(clock+info), right-half(3 buttons)
 // ============================================================
+static int homeStatusId = WIDGET_NONE;
+
+static void drawHomeStatus(int id) {
+  const Widget &w = widgetGet(id);
+  bool on = schedulerIsEnabled();
+  canvas.fillRect(w.x, w.y, w.w, w.h, COL_BG);
+  canvas.setFont(uiFont(FONT_BODY));
+  canvas.setTextDatum(middle_center);
+  canvas.setTextColor(on ? COL_SUCCESS : COL_DANGER, COL_BG);
+  canvas.drawString(tr(on ? STR_SCHEDULE_ON : STR_SCHEDULE_OFF), 175, 197);
+}
+
+static void drawAutoToggle(int id) {
+  const Widget &w = widgetGet(id);
+  bool on = schedulerIsEnabled();
+  clearWidget(w, COL_BG);
+  btn(w.x, w.y, w.w, w.h, tr(on ? STR_ON : STR_OFF), on ? COL_SUCCESS : COL_BTN,
+      COL_TEXT);
+}
+
 static void drawHome() {
   auto &lcd = canvas;
 
   // Header bar
   lcd.fillRect(0, 0, 480, 44, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  lcd.drawString("Medicine Dispenser", 240, 22);
+  lcd.drawString(tr(STR_TITLE), 240, 22);
 
-  // --- Left side: Clock ---
-  uint8_t h, m, s;
-  schedulerGetTime(h, m, s);
-  char timeBuf[9];
-  sprintf(timeBuf, "%02d:%02d:%02d", h, m, s);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
-  lcd.setTextDatum(middle_center);
-  lcd.setTextColor(COL_TEXT, COL_BG);
-  lcd.drawString(timeBuf, 175, 95);
+  // --- Left side: Clock + next schedule ---
+  dynamic([] { showLive(homeLive, drawHomeLive); });
 
   // Date
   uint16_t yr;
   uint8_t mo, dy, dow;
   schedulerGetDate(yr, mo, dy, dow);
-  const char *dn[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
-  char dateBuf[24];
-  sprintf(dateBuf, "%s %02d/%02d/%04d", dn[dow], dy, mo, yr);
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  char dateBuf[32];
+  sprintf(dateBuf, "%s %02d/%02d/%04d", uiLang->dayName[dow], dy, mo, yr);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextColor(COL_TEXT_DIM, COL_BG);
   lcd.setTextDatum(middle_center);
   lcd.drawString(dateBuf, 175, 135);
 
-  // Next schedule
-  int next = schedulerNextSlot();
-  lcd.setFont(&fonts::FreeSans12pt7b);
-  if (next >= 0) {
-    TimeSlot &ts = timeSlotGet(next);
-    char nb[40];
-    sprintf(nb, "Next: %s  %02d:%02d", slotShort[next], ts.hour, ts.minute);
-    lcd.setTextColor(COL_SUCCESS, COL_BG);
-    lcd.drawString(nb, 175, 172);
-  } else {
-    lcd.setTextColor(COL_TEXT_DIM, COL_BG);
-    lcd.drawString("No upcoming schedule", 175, 172);
-  }
-
   // Status indicator
-  bool on = schedulerIsEnabled();
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextColor(on ? COL_SUCCESS : COL_DANGER, COL_BG);
-  lcd.drawString(on ? "Schedule: ON" : "Schedule: OFF", 175, 197);
+  homeStatusId = widgetAdd(95, 187, 160, 20, nullptr, 0, drawHomeStatus);
+  dynamic([] { widgetInvalidate(homeStatusId); });
 
   // Vertical divider
   lcd.drawFastVLine(345, 50, 220, COL_DIVIDER);
 
   // --- Right side: 3 buttons + toggle ---
-  btn(360, 55, 110, 50, "Schedule", COL_PRIMARY, COL_TEXT_INV);
-  btn(360, 115, 110, 50, "Modules", COL_ACCENT, COL_TEXT_INV);
-  btn(360, 175, 110, 50, "Dispense", COL_DANGER, COL_TEXT);
+  button(360, 55, 110, 50, tr(STR_SCHEDULE), COL_PRIMARY, COL_TEXT_INV,
+         [](int) {
+           Serial.println("[UI] -> Schedule");
+           switchTo(SCREEN_SCHEDULE);
+         });
+  button(360, 115, 110, 50, tr(STR_MODULES), COL_ACCENT, COL_TEXT_INV, [](int) {
+    Serial.println("[UI] -> Modules");
+    modScroll = 0;
+    switchTo(SCREEN_MODULES);
+  });
+  button(360, 175, 110, 50, tr(STR_DISPENSE), COL_DANGER, COL_TEXT, [](int) {
+    Serial.println("[UI] -> Manual Dispense Screen");
+    switchTo(SCREEN_MANUAL_DISPENSE);
+  });
 
   // Bottom toggle
   lcd.drawFastHLine(0, 270, 480, COL_DIVIDER);
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(middle_left);
   lcd.setTextColor(COL_TEXT_DIM, COL_BG);
-  lcd.drawString("Auto:", 15, 295);
-  btn(65, 280, 80, 30, on ? "ON" : "OFF", on ? COL_SUCCESS : COL_BTN, COL_TEXT);
+  lcd.drawString(tr(STR_AUTO), 15, 295);
+  int toggle = widgetAdd(
+      65, 280, 80, 30,
+      [](int id) {
+        Serial.println("[UI] Toggle schedule");
+        schedulerSetEnabled(!schedulerIsEnabled());
+        schedulerSave();
+        widgetInvalidate(id);
+        widgetInvalidate(homeStatusId);
+      },
+      0, drawAutoToggle);
+  dynamic([&] { widgetInvalidate(toggle); });
+
+  // Language: cycles through the tables
+  button(355, 280, 115, 30, uiLang->name, COL_BTN, COL_TEXT, [](int) {
+    setLanguage((Lang)((langGet() + 1) % LANG_COUNT));
+  });
 
   // WiFi Button
   bool wifiOk = wifiIsConnected();
-  btn(160, 280, 180, 30, wifiOk ? wifiGetSSID().c_str() : "WiFi: Disconnected",
-      wifiOk ? COL_SUCCESS : COL_BTN, wifiOk ? COL_BG : COL_DANGER);
+  button(160, 280, 180, 30,
+         wifiOk ? wifiGetSSID().c_str() : tr(STR_WIFI_DISCONNECTED),
+         wifiOk ? COL_SUCCESS : COL_BTN, wifiOk ? COL_BG : COL_DANGER,
+         [](int) {
+           Serial.println("[UI] -> WiFi Menu");
+           switchTo(SCREEN_WIFI_MENU);
+         });
+}
+
+// Big HH:MM:SS clock over its own background box; HH:MM once the
+// governor has gone idle
+static void drawClock() {
+  uint8_t h, m, s;
+  schedulerGetTime(h, m, s);
+  clockSeconds = powerState() == POWER_ACTIVE;
+  lastClockMinute = m;
+  char buf[9];
+  if (clockSeconds)
+    sprintf(buf, "%02d:%02d:%02d", h, m, s);
+  else
+    sprintf(buf, "%02d:%02d", h, m);
+
+  canvas.setFont(FONT_CLOCK);
+  canvas.setTextDatum(middle_center);
+  canvas.setTextColor(COL_TEXT, COL_BG);
+  int fh = canvas.fontHeight();
+  canvas.fillRect(20, 95 - fh / 2, 310, fh, COL_BG);
+  canvas.drawString(buf, 175, 95);
+}
+
+// "Next: ..." line
+static void drawNextSchedule() {
+  char nb[64];
+  uint32_t at;
+  int slot;
+  uint8_t mods;
+  bool next = schedulerNextDose(at, slot, mods);
+  if (next) {
+    // An own-time rule goes by its first module's name
+    const char *what =
+        slot >= 0 ? uiLang->slotShort[slot]
+                  : langModuleName(moduleGet(__builtin_ctz(mods)).name);
+    sprintf(nb, tr(STR_NEXT_FMT), what, (int)(at % 86400 / 3600),
+            (int)(at / 60 % 60));
+  } else {
+    strcpy(nb, tr(STR_NO_UPCOMING));
+  }
+
+  canvas.setFont(uiFont(FONT_LARGE));
+  canvas.setTextDatum(middle_center);
+  canvas.fillRect(30, 153, 300, 35, COL_BG);
+  canvas.setTextColor(next ? COL_SUCCESS : COL_TEXT_DIM, COL_BG);
+  canvas.drawString(nb, 175, 172);
+}
+
+// Once a second only the clock digits that changed are replayed; the
+// "Next:" line only when its text changes
+static void drawHomeLive() {
+  drawClock();
+  drawNextSchedule();
 }
 
 // ============================================================
 // SCHEDULE SCREEN — 2x2 grid (4 periods)
+// Each slot row is a node whose children are the time and ON buttons.
 // ============================================================
+static void drawSlotTime(int id) {
+  const Widget &w = widgetGet(id);
+  TimeSlot &t = timeSlotGet(w.arg);
+  char b[8];
+  sprintf(b, "%02d:%02d", t.hour, t.minute);
+  clearWidget(w, COL_CARD);
+  btn(w.x, w.y, w.w, w.h, b, t.enabled ? COL_PRIMARY : COL_BTN, COL_TEXT);
+}
+
+static void drawSlotToggle(int id) {
+  const Widget &w = widgetGet(id);
+  TimeSlot &t = timeSlotGet(w.arg);
+  clearWidget(w, COL_CARD);
+  btn(w.x, w.y, w.w, w.h, t.enabled ? tr(STR_ON) : "--",
+      t.enabled ? COL_SUCCESS : COL_BTN, COL_TEXT);
+}
+
+static void addSlotRow(int slot, int x, int y) {
+  int row = widgetAdd(x, y, 120, 28, nullptr, slot);
+  widgetAdd(
+      x, y, 80, 28,
+      [](int id) {
+        editSlotIdx = widgetArg(id);
+        editH = timeSlotGet(editSlotIdx).hour;
+        editM = timeSlotGet(editSlotIdx).minute;
+        switchTo(SCREEN_TIME_PICKER);
+      },
+      slot, drawSlotTime, row);
+  widgetAdd(
+      x + 88, y, 32, 28,
+      [](int id) {
+        TimeSlot &t = timeSlotGet(widgetArg(id));
+        timeSlotSet(widgetArg(id), t.hour, t.minute, !t.enabled);
+        widgetInvalidate(widgetGet(id).parent); // time + toggle colours
+      },
+      slot, drawSlotToggle, row);
+  dynamic([&] { widgetInvalidate(row); });
+}
+
 static void drawSchedule() {
   auto &lcd = canvas;
 
   // Header
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  lcd.drawString("Schedule", 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
+  lcd.drawString(tr(STR_SCHEDULE), 240, 20);
+  backButton([](int) {
+    schedulerSave();
+    switchTo(SCREEN_HOME);
+  });
 
   // 2x2 grid
   int cw = 228, ch = 125;
@@ -447,69 +812,107 @@ static void drawSchedule() {
     drawShadowCard(cx, cy, cw, ch);
 
     // Period label
-    lcd.setFont(&fonts::FreeSans9pt7b);
+    lcd.setFont(uiFont(FONT_BODY));
     lcd.setTextDatum(top_left);
     lcd.setTextColor(COL_PRIMARY, COL_CARD);
-    lcd.drawString(periodName[p], cx + 12, cy + 8);
+    lcd.drawString(uiLang->periodName[p], cx + 12, cy + 8);
 
     // Divider inside card
     lcd.drawFastHLine(cx + 8, cy + 28, cw - 16, COL_DIVIDER);
 
-    lcd.setFont(&fonts::FreeSans9pt7b);
+    lcd.setFont(uiFont(FONT_BODY));
 
     if (p < 3) {
-      int s1 = p * 2, s2 = p * 2 + 1;
-      TimeSlot &t1 = timeSlotGet(s1);
-      TimeSlot &t2 = timeSlotGet(s2);
-
       // Before meal
       lcd.setTextDatum(middle_left);
       lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-      lcd.drawString("Before", cx + 12, cy + 48);
-      char b1[8];
-      sprintf(b1, "%02d:%02d", t1.hour, t1.minute);
-      btn(cx + 100, cy + 35, 80, 28, b1, t1.enabled ? COL_PRIMARY : COL_BTN,
-          COL_TEXT);
-      btn(cx + 188, cy + 35, 32, 28, t1.enabled ? "ON" : "--",
-          t1.enabled ? COL_SUCCESS : COL_BTN, COL_TEXT);
+      lcd.drawString(tr(STR_BEFORE), cx + 12, cy + 48);
+      addSlotRow(p * 2, cx + 100, cy + 35);
 
       // After meal
+      lcd.setFont(uiFont(FONT_BODY));
       lcd.setTextDatum(middle_left);
       lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-      lcd.drawString("After", cx + 12, cy + 88);
-      char b2[8];
-      sprintf(b2, "%02d:%02d", t2.hour, t2.minute);
-      btn(cx + 100, cy + 75, 80, 28, b2, t2.enabled ? COL_PRIMARY : COL_BTN,
-          COL_TEXT);
-      btn(cx + 188, cy + 75, 32, 28, t2.enabled ? "ON" : "--",
-          t2.enabled ? COL_SUCCESS : COL_BTN, COL_TEXT);
+      lcd.drawString(tr(STR_AFTER), cx + 12, cy + 88);
+      addSlotRow(p * 2 + 1, cx + 100, cy + 75);
     } else {
       // Bedtime — single row centered
-      TimeSlot &t6 = timeSlotGet(6);
       lcd.setTextDatum(middle_left);
       lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-      lcd.drawString("Time", cx + 12, cy + 65);
-      char b6[8];
-      sprintf(b6, "%02d:%02d", t6.hour, t6.minute);
-      btn(cx + 100, cy + 52, 80, 28, b6, t6.enabled ? COL_PRIMARY : COL_BTN,
-          COL_TEXT);
-      btn(cx + 188, cy + 52, 32, 28, t6.enabled ? "ON" : "--",
-          t6.enabled ? COL_SUCCESS : COL_BTN, COL_TEXT);
+      lcd.drawString(tr(STR_TIME), cx + 12, cy + 65);
+      addSlotRow(6, cx + 100, cy + 52);
     }
   }
 }
 
 // ============================================================
 // TIME PICKER
+// Hour and minute columns: [+] value [-], the value node repaints alone.
 // ============================================================
+static void drawPickerValue(int id) {
+  const Widget &w = widgetGet(id);
+  char buf[4];
+  sprintf(buf, "%02d", w.arg == 0 ? editH : editM);
+  canvas.fillRect(w.x, w.y, w.w, w.h, COL_CARD);
+  canvas.setFont(uiFont(FONT_TITLE));
+  canvas.setTextDatum(middle_center);
+  canvas.setTextColor(COL_TEXT, COL_CARD);
+  canvas.drawString(buf, w.x + w.w / 2, 145);
+}
+
+// +/- handler: arg = column (0 hour, 1 minute) * 2 + (0 up, 1 down)
+static void pickerStep(int id) {
+  int a = widgetArg(id);
+  if (a == 0)
+    editH = (editH + 1) % 24;
+  else if (a == 1)
+    editH = (editH + 23) % 24;
+  else if (a == 2)
+    editM = (editM + 5) % 60;
+  else
+    editM = (editM + 55) % 60;
+  widgetInvalidate(widgetGet(id).parent);
+}
+
+static int pickerColumns[2];
+
+static void addPickerColumn(int column, int x) {
+  int col = widgetAdd(x, 90, 60, 110, nullptr, column);
+  pickerColumns[column] = col;
+  widgetSetFlags(button(x, 90, 60, 35, "+", COL_PRIMARY, COL_TEXT_INV,
+                        pickerStep, column * 2, col),
+                 WIDGET_REPEAT);
+  widgetAdd(x, 128, 60, 34, nullptr, column, drawPickerValue, col);
+  widgetSetFlags(button(x, 165, 60, 35, "-", COL_PRIMARY, COL_TEXT_INV,
+                        pickerStep, column * 2 + 1, col),
+                 WIDGET_REPEAT);
+  dynamic([&] { widgetInvalidate(col); });
+}
+
+// Vertical swipe on a column spins it: one step per 20 px of travel,
+// doubled for a flick. Up = increase.
+static void pickerSwipe(const Gesture &g) {
+  if (g.dir != SWIPE_UP && g.dir != SWIPE_DOWN)
+    return;
+  int column = g.x < 240 ? 0 : 1;
+  int steps = abs(g.dy) / 20 * (g.flick ? 2 : 1);
+  if (g.dir == SWIPE_DOWN)
+    steps = -steps;
+  if (column == 0)
+    editH = ((editH + steps) % 24 + 24) % 24;
+  else
+    editM = ((editM + steps * 5) % 60 + 60) % 60;
+  widgetInvalidate(pickerColumns[column]);
+}
+
 static void drawTimePicker() {
   auto &lcd = canvas;
 
   // Header
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  char title[32];
-  sprintf(title, "Set Time - %s", slotShort[editSlotIdx]);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  char title[48];
+  sprintf(title, tr(STR_SET_TIME_FMT), uiLang->slotShort[editSlotIdx]);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
   lcd.drawString(title, 240, 20);
@@ -518,557 +921,394 @@ static void drawTimePicker() {
   lcd.fillRoundRect(80, 60, 320, 140, 10, COL_CARD);
 
   // Labels
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-  lcd.drawString("Hour", 180, 80);
-  lcd.drawString("Min", 300, 80);
+  lcd.drawString(tr(STR_HOUR), 180, 80);
+  lcd.drawString(tr(STR_MIN), 300, 80);
 
-  // Hour +/-
-  btn(150, 90, 60, 35, "+", COL_PRIMARY, COL_TEXT_INV);
-  btn(150, 165, 60, 35, "-", COL_PRIMARY, COL_TEXT_INV);
+  // Hour / minute columns
+  addPickerColumn(0, 150);
+  addPickerColumn(1, 270);
+  screenSwipe = pickerSwipe;
 
-  // Minute +/-
-  btn(270, 90, 60, 35, "+", COL_PRIMARY, COL_TEXT_INV);
-  btn(270, 165, 60, 35, "-", COL_PRIMARY, COL_TEXT_INV);
-
-  // Time display
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
-  lcd.setTextColor(COL_TEXT, COL_CARD);
-  char hBuf[4];
-  sprintf(hBuf, "%02d", editH);
-  char mBuf[4];
-  sprintf(mBuf, "%02d", editM);
-  lcd.drawString(hBuf, 180, 145);
   lcd.setTextColor(COL_PRIMARY, COL_CARD);
   lcd.drawString(":", 240, 140);
-  lcd.setTextColor(COL_TEXT, COL_CARD);
-  lcd.drawString(mBuf, 300, 145);
 
   // Save / Cancel
-  btn(100, 230, 140, 45, "Save", COL_SUCCESS, COL_TEXT);
-  btn(260, 230, 140, 45, "Cancel", COL_BTN, COL_TEXT);
+  button(100, 230, 140, 45, tr(STR_SAVE), COL_SUCCESS, COL_TEXT, [](int) {
+    timeSlotSet(editSlotIdx, editH, editM, timeSlotGet(editSlotIdx).enabled);
+    schedulerSave();
+    switchTo(SCREEN_SCHEDULE);
+  });
+  button(260, 230, 140, 45, tr(STR_CANCEL), COL_BTN, COL_TEXT,
+         [](int) { switchTo(SCREEN_SCHEDULE); });
 }
 
 // ============================================================
-// MODULES LIST — 3 per page
+// MODULES LIST — kinetic scroll list, one card per row
 // ============================================================
+#define MOD_ROW_H 84
+
+static void drawModuleRow(LGFX_Sprite &row, int idx) {
+  MedModule &mod = moduleGet(idx);
+  row.fillScreen(COL_BG);
+  shadowCardOn(row, 0, 0, 452, 76); // leaves room for the scroll thumb
+
+  // Module number badge
+  row.fillRoundRect(8, 6, 30, 24, 4, COL_PRIMARY);
+  row.setFont(uiFont(FONT_BODY));
+  row.setTextDatum(middle_center);
+  row.setTextColor(COL_TEXT_INV, COL_PRIMARY);
+  char num[4];
+  sprintf(num, "%d", idx + 1);
+  row.drawString(num, 23, 18);
+
+  // Icon + name
+  assetDraw(row, moduleIcon(mod.name), 44, 6);
+  row.setFont(uiFont(FONT_BODY));
+  row.setTextDatum(middle_left);
+  row.setTextColor(COL_TEXT, COL_CARD);
+  row.drawString(langModuleName(mod.name), 74, 18);
+
+  // Qty (right side)
+  char qBuf[10];
+  sprintf(qBuf, "x%d", mod.qty);
+  row.setFont(uiFont(FONT_TITLE));
+  row.setTextDatum(middle_right);
+  row.setTextColor(COL_ACCENT, COL_CARD);
+  row.drawString(qBuf, 440, 18);
+
+  // Slot chips row
+  row.setFont(uiFont(FONT_SMALL));
+  for (int s = 0; s < NUM_TIME_SLOTS; s++) {
+    bool on = mod.slotMask & (1 << s);
+    int px = 8 + s * 62;
+    int py = 46;
+    row.fillRoundRect(px, py, 56, 22, 4, on ? COL_ACCENT : COL_BTN);
+    row.setTextDatum(middle_center);
+    row.setTextColor(on ? COL_BG : COL_TEXT_DIM, on ? COL_ACCENT : COL_BTN);
+    row.drawString(uiLang->slotShort[s], px + 28, py + 11);
+  }
+}
+
 static void drawModules() {
   auto &lcd = canvas;
 
   // Header
   lcd.fillRect(0, 0, 480, 40, COL_ACCENT);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_ACCENT);
-  lcd.drawString("Medicine Modules", 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
-
-  // Page
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextColor(COL_TEXT_INV, COL_ACCENT);
-  lcd.setTextDatum(middle_right);
-  lcd.drawString(modPage == 0 ? "1/2" : "2/2", 470, 20);
-
-  // 3 cards
-  for (int i = 0; i < 3; i++) {
-    int idx = modPage + i;
-    if (idx >= NUM_MODULES)
-      break;
-    MedModule &mod = moduleGet(idx);
-    int cy = 48 + i * 84;
-
-    // Card
-    drawShadowCard(10, cy, 460, 76);
-
-    // Module number badge
-    lcd.fillRoundRect(18, cy + 6, 30, 24, 4, COL_PRIMARY);
-    lcd.setFont(&fonts::FreeSans9pt7b);
-    lcd.setTextDatum(middle_center);
-    lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-    char num[3];
-    sprintf(num, "%d", idx + 1);
-    lcd.drawString(num, 33, cy + 18);
-
-    // Name
-    lcd.setFont(&fonts::FreeSans9pt7b);
-    lcd.setTextDatum(middle_left);
-    lcd.setTextColor(COL_TEXT, COL_CARD);
-    lcd.drawString(mod.name, 56, cy + 18);
-
-    // Qty (right side)
-    char qBuf[10];
-    sprintf(qBuf, "x%d", mod.qty);
-    lcd.setFont(&fonts::FreeSansBold12pt7b);
-    lcd.setTextDatum(middle_right);
-    lcd.setTextColor(COL_ACCENT, COL_CARD);
-    lcd.drawString(qBuf, 458, cy + 18);
-
-    // Slot chips row
-    lcd.setFont(&fonts::Font2);
-    for (int s = 0; s < NUM_TIME_SLOTS; s++) {
-      bool on = mod.slotMask & (1 << s);
-      int px = 18 + s * 62;
-      int py = cy + 46;
-      lcd.fillRoundRect(px, py, 56, 22, 4, on ? COL_ACCENT : COL_BTN);
-      lcd.setTextDatum(middle_center);
-      lcd.setTextColor(on ? COL_BG : COL_TEXT_DIM, on ? COL_ACCENT : COL_BTN);
-      lcd.drawString(slotShort[s], px + 28, py + 11);
-    }
-  }
-
-  // Nav buttons
-  if (modPage > 0)
-    btn(10, 300, 90, 18, "< Prev", COL_BTN, COL_TEXT);
-  if (modPage + 3 < NUM_MODULES)
-    btn(380, 300, 90, 18, "Next >", COL_BTN, COL_TEXT);
+  lcd.drawString(tr(STR_MED_MODULES), 240, 20);
+  backButton([](int) { switchTo(SCREEN_HOME); });
+
+  // Cards → detail
+  dynamic([] {
+    listBegin(10, 48, 460, LCD_HEIGHT - 48, MOD_ROW_H, NUM_MODULES,
+              drawModuleRow,
+              [](int idx) {
+                editModIdx = idx;
+                modScroll = listScrollY();
+                Serial.printf("[UI] Module %d tapped\n", editModIdx);
+                switchTo(SCREEN_MODULE_DETAIL);
+              },
+              modScroll);
+  });
 }
 
 // ============================================================
 // MODULE DETAIL — edit name, qty, slot toggles
 // ============================================================
+static void drawModuleName(int id) {
+  const Widget &w = widgetGet(id);
+  const char *name = moduleGet(editModIdx).name;
+  canvas.fillRect(w.x, w.y, w.w, w.h, COL_CARD);
+  assetDraw(canvas, moduleIcon(name), w.x + 6, w.y + 1);
+  canvas.setFont(uiFont(FONT_BODY));
+  canvas.setTextColor(COL_TEXT, COL_CARD);
+  canvas.setTextDatum(middle_center);
+  canvas.drawString(langModuleName(name), 240, 75);
+}
+
+static void drawModuleQty(int id) {
+  const Widget &w = widgetGet(id);
+  char qBuf[6];
+  sprintf(qBuf, "%d", moduleGet(editModIdx).qty);
+  canvas.fillRect(w.x, w.y, w.w, w.h, COL_CARD);
+  canvas.setFont(uiFont(FONT_TITLE));
+  canvas.setTextDatum(middle_center);
+  canvas.setTextColor(COL_TEXT, COL_CARD);
+  canvas.drawString(qBuf, 290, 138);
+}
+
+static void drawSlotChip(int id) {
+  const Widget &w = widgetGet(id);
+  bool on = moduleGet(editModIdx).slotMask & (1 << w.arg);
+  clearWidget(w, COL_CARD);
+  btn(w.x, w.y, w.w, w.h, uiLang->slotShort[w.arg], on ? COL_ACCENT : COL_BTN,
+      on ? COL_BG : COL_TEXT_DIM);
+}
+
+// Qty -/+ handler: arg = step
+static void qtyStep(int id) {
+  MedModule &mod = moduleGet(editModIdx);
+  int q = mod.qty + widgetArg(id);
+  if (q >= 0 && q <= 99)
+    mod.qty = q;
+  widgetInvalidate(widgetGet(id).parent);
+}
+
 static void drawModuleDetail() {
   auto &lcd = canvas;
-  MedModule &mod = moduleGet(editModIdx);
 
   // Header
   lcd.fillRect(0, 0, 480, 40, COL_ACCENT);
-  char title[20];
-  sprintf(title, "Module %d", editModIdx + 1);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  char title[40];
+  sprintf(title, tr(STR_MODULE_FMT), editModIdx + 1);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_ACCENT);
   lcd.drawString(title, 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
+  backButton([](int) { switchTo(SCREEN_MODULES); });
 
   // --- Name ---
   drawShadowCard(15, 50, 450, 50);
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(middle_left);
   lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-  lcd.drawString("Name:", 25, 75);
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextColor(COL_TEXT, COL_CARD);
-  lcd.setTextDatum(middle_center);
-  lcd.drawString(mod.name, 240, 75);
-  btn(380, 58, 75, 34, "Change", COL_PRIMARY, COL_TEXT_INV);
+  lcd.drawString(tr(STR_NAME), 25, 75);
+  int nameCard = widgetAdd(15, 50, 450, 50, nullptr);
+  widgetAdd(100, 62, 275, 26, nullptr, 0, drawModuleName, nameCard);
+  button(
+      380, 58, 75, 34, tr(STR_CHANGE), COL_PRIMARY, COL_TEXT_INV,
+      [](int id) {
+        MedModule &mod = moduleGet(editModIdx);
+        int cur = langPresetFind(mod.name);
+        cur = cur < 0 ? 0 : (cur + 1) % NUM_PRESETS;
+        moduleSetName(editModIdx, langPresetKey(cur));
+        widgetInvalidate(widgetGet(id).parent);
+      },
+      0, nameCard);
+  dynamic([&] { widgetInvalidate(nameCard); });
 
   // --- Qty ---
   drawShadowCard(15, 110, 450, 55);
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(middle_left);
   lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-  lcd.drawString("Qty:", 25, 138);
-  btn(180, 118, 60, 38, "-", COL_PRIMARY, COL_TEXT_INV);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
-  lcd.setTextDatum(middle_center);
-  lcd.setTextColor(COL_TEXT, COL_CARD);
-  char qBuf[6];
-  sprintf(qBuf, "%d", mod.qty);
-  lcd.drawString(qBuf, 290, 138);
-  btn(360, 118, 60, 38, "+", COL_PRIMARY, COL_TEXT_INV);
+  lcd.drawString(tr(STR_QTY), 25, 138);
+  int qtyCard = widgetAdd(15, 110, 450, 55, nullptr);
+  widgetSetFlags(button(180, 118, 60, 38, "-", COL_PRIMARY, COL_TEXT_INV,
+                        qtyStep, -1, qtyCard),
+                 WIDGET_REPEAT);
+  widgetAdd(245, 122, 110, 32, nullptr, 0, drawModuleQty, qtyCard);
+  widgetSetFlags(button(360, 118, 60, 38, "+", COL_PRIMARY, COL_TEXT_INV,
+                        qtyStep, 1, qtyCard),
+                 WIDGET_REPEAT);
+  dynamic([&] { widgetInvalidate(qtyCard); });
 
   // --- Slot toggles ---
   drawShadowCard(15, 175, 450, 85);
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextDatum(top_left);
   lcd.setTextColor(COL_TEXT_DIM, COL_CARD);
-  lcd.drawString("Dispense at:", 25, 182);
+  lcd.drawString(tr(STR_DISPENSE_AT), 25, 182);
 
   // 7 chips: row 1 = 4, row 2 = 3
   for (int s = 0; s < NUM_TIME_SLOTS; s++) {
-    bool on = mod.slotMask & (1 << s);
     int col = s % 4;
     int row = s / 4;
     int px = 22 + col * 112;
     int py = 204 + row * 30;
-    btn(px, py, 104, 26, slotShort[s], on ? COL_ACCENT : COL_BTN,
-        on ? COL_BG : COL_TEXT_DIM);
+    int chip = widgetAdd(
+        px, py, 104, 26,
+        [](int id) {
+          moduleToggleSlot(editModIdx, widgetArg(id));
+          widgetInvalidate(id);
+        },
+        s, drawSlotChip);
+    dynamic([&] { widgetInvalidate(chip); });
   }
 
   // Save
-  btn(140, 272, 200, 42, "Save", COL_SUCCESS, COL_TEXT);
+  button(140, 272, 200, 42, tr(STR_SAVE), COL_SUCCESS, COL_TEXT, [](int) {
+    schedulerSave();
+    switchTo(SCREEN_MODULES);
+  });
 }
-
 // ============================================================
 // DISPENSING / RESULT
+// Both screens animate through tweens; nothing here blocks the loop.
 // ============================================================
-void uiShowDispensing(int moduleIndex) {
-  LGFX &lcd = getDisplay();
-  lcd.fillScreen(COL_BG);
+static int dispModuleIdx = 0;
+static int dispDotsDrawn = 0;
+static bool resultOk = true;
+
+// Dots fill in over 800 ms, then hold until the servo has returned
+static const Keyframe dispenseFrames[] = {{0, 0}, {800, 8}, {1300, 8}};
+
+static void onDispenseDots(float value, int) {
+  int n = (int)value;
+  for (; dispDotsDrawn < n; dispDotsDrawn++)
+    canvas.fillCircle(200 + dispDotsDrawn * 12, 200, 5, COL_PRIMARY);
+}
 
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+static void drawDispensing() {
+  auto &lcd = canvas;
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_PRIMARY, COL_BG);
-  lcd.drawString("Dispensing...", 240, 100);
+  lcd.drawString(tr(STR_DISPENSING), 240, 100);
+
+  dynamic([&] {
+    MedModule &mod = moduleGet(dispModuleIdx);
+    char buf[64];
+    sprintf(buf, tr(STR_MODULE_NAME_FMT), dispModuleIdx + 1,
+            langModuleName(mod.name));
+    lcd.setFont(uiFont(FONT_BODY));
+    lcd.setTextColor(COL_TEXT_DIM, COL_BG);
+    lcd.drawString(buf, 240, 140);
+  });
+}
 
-  MedModule &mod = moduleGet(moduleIndex);
-  char buf[32];
-  sprintf(buf, "Module %d: %s", moduleIndex + 1, mod.name);
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextColor(COL_TEXT_DIM, COL_BG);
-  lcd.drawString(buf, 240, 140);
+void uiShowDispensing(int moduleIndex) {
+  dispModuleIdx = moduleIndex;
+  dispDotsDrawn = 0;
+  switchTo(SCREEN_DISPENSING);
+  animStart(dispenseFrames, 3, EASE_LINEAR, onDispenseDots);
+}
 
-  // Simple loading animation
-  for (int f = 0; f < 8; f++) {
-    lcd.fillCircle(200 + f * 12, 200, 5, COL_PRIMARY);
-    delay(100);
+// Badge radius pops past 50 px and settles
+static void onResultBadge(float r, int) {
+  uint16_t col = resultOk ? COL_SUCCESS : COL_DANGER;
+  canvas.fillRect(180, 50, 120, 120, COL_BG);
+  if (r >= 1)
+    canvas.fillCircle(240, 110, (int)r, col);
+  if (r >= 40) {
+#if UI_CANVAS_BPP == 16
+    assetDraw(canvas, resultOk ? ICON_STATUS_OK : ICON_STATUS_FAIL, 224, 94);
+#else
+    canvas.setFont(uiFont(FONT_TITLE));
+    canvas.setTextDatum(middle_center);
+    canvas.setTextColor(COL_TEXT_INV, col);
+    canvas.drawString(resultOk ? "OK" : "X", 240, 110);
+#endif
   }
-  delay(200);
 }
 
-void uiShowResult(int timeSlotIndex, bool success) {
-  LGFX &lcd = getDisplay();
-  lcd.fillScreen(COL_BG);
-
-  uint16_t col = success ? COL_SUCCESS : COL_DANGER;
+// "Returning home" progress bar, 0..1
+static void onResultProgress(float v, int) {
+  canvas.fillRoundRect(140, 270, (int)(200 * v), 8, 4, COL_PRIMARY);
+}
 
-  // Big circle
-  lcd.fillCircle(240, 110, 50, col);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
-  lcd.setTextDatum(middle_center);
-  lcd.setTextColor(COL_TEXT_INV, col);
-  lcd.drawString(success ? "OK" : "X", 240, 110);
+static void drawResult() {
+  auto &lcd = canvas;
+  uint16_t col = resultOk ? COL_SUCCESS : COL_DANGER;
 
   // Message
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
+  lcd.setTextDatum(middle_center);
   lcd.setTextColor(col, COL_BG);
-  lcd.drawString(success ? "Dispensed!" : "Error!", 240, 200);
+  lcd.drawString(tr(resultOk ? STR_DISPENSED : STR_ERROR), 240, 200);
 
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextColor(COL_TEXT_DIM, COL_BG);
-  lcd.drawString("Returning home...", 240, 250);
-
-  delay(3000);
-  switchTo(SCREEN_HOME);
+  lcd.drawString(tr(STR_RETURNING), 240, 250);
+  lcd.fillRoundRect(140, 270, 200, 8, 4, COL_BTN);
 }
 
-// ============================================================
-// TOUCH: HOME
-// ============================================================
-static void touchHome(int x, int y) {
-  // Schedule: 360-470, 55-105
-  if (x >= 360 && x <= 470 && y >= 55 && y <= 105) {
-    Serial.println("[UI] -> Schedule");
-    switchTo(SCREEN_SCHEDULE);
-    return;
-  }
-  // Modules: 360-470, 115-165
-  if (x >= 360 && x <= 470 && y >= 115 && y <= 165) {
-    Serial.println("[UI] -> Modules");
-    modPage = 0;
-    switchTo(SCREEN_MODULES);
-    return;
-  }
-  // Dispense: 360-470, 175-225
-  if (x >= 360 && x <= 470 && y >= 175 && y <= 225) {
-    Serial.println("[UI] -> Manual Dispense Screen");
-    switchTo(SCREEN_MANUAL_DISPENSE);
-    return;
-  }
-  // Toggle: 65-145, 280-310
-  if (x >= 65 && x <= 145 && y >= 280 && y <= 310) {
-    Serial.println("[UI] Toggle schedule");
-    schedulerSetEnabled(!schedulerIsEnabled());
-    schedulerSave();
-    switchTo(SCREEN_HOME);
-    return;
-  }
-  // WiFi: 160-340, 280-310
-  if (x >= 160 && x <= 340 && y >= 280 && y <= 310) {
-    Serial.println("[UI] -> WiFi Menu");
-    switchTo(SCREEN_WIFI_MENU);
-    return;
-  }
+void uiShowResult(int timeSlotIndex, bool success) {
+  resultOk = success;
+  switchTo(SCREEN_RESULT);
+  animTween(0, 50, 400, EASE_OUT_BACK, onResultBadge);
+  animTween(0, 1, 3000, EASE_LINEAR, onResultProgress,
+            [](int) { transitionTo(SCREEN_HOME); });
 }
 
-// ============================================================
-// TOUCH: SCHEDULE
-// ============================================================
-static void touchSchedule(int x, int y) {
-  // Back: 5-65, 5-35
-  if (x <= 65 && y <= 40) {
-    schedulerSave();
-    switchTo(SCREEN_HOME);
-    return;
-  }
+bool uiIsAnimating(void) { return animActive(); }
 
-  int startX = 5, startY = 46;
-
-  for (int p = 0; p < 4; p++) {
-    int c = p % 2, r = p / 2;
-    int cx = startX + c * 237;
-    int cy = startY + r * 132;
-
-    // Skip if touch not in this card
-    if (x < cx || x > cx + 228 || y < cy || y > cy + 125)
-      continue;
-
-    Serial.printf("[UI] Schedule card %d touched\n", p);
-
-    if (p < 3) {
-      int s1 = p * 2, s2 = p * 2 + 1;
-
-      // Before time: cx+100..cx+180, cy+35..cy+63
-      if (x >= cx + 100 && x <= cx + 180 && y >= cy + 35 && y <= cy + 63) {
-        editSlotIdx = s1;
-        editH = timeSlotGet(s1).hour;
-        editM = timeSlotGet(s1).minute;
-        switchTo(SCREEN_TIME_PICKER);
-        return;
-      }
-      // Before toggle: cx+188..cx+220, cy+35..cy+63
-      if (x >= cx + 188 && x <= cx + 220 && y >= cy + 35 && y <= cy + 63) {
-        timeSlotGet(s1).enabled = !timeSlotGet(s1).enabled;
-        switchTo(SCREEN_SCHEDULE);
-        return;
-      }
-      // After time: cx+100..cx+180, cy+75..cy+103
-      if (x >= cx + 100 && x <= cx + 180 && y >= cy + 75 && y <= cy + 103) {
-        editSlotIdx = s2;
-        editH = timeSlotGet(s2).hour;
-        editM = timeSlotGet(s2).minute;
-        switchTo(SCREEN_TIME_PICKER);
-        return;
-      }
-      // After toggle: cx+188..cx+220, cy+75..cy+103
-      if (x >= cx + 188 && x <= cx + 220 && y >= cy + 75 && y <= cy + 103) {
-        timeSlotGet(s2).enabled = !timeSlotGet(s2).enabled;
-        switchTo(SCREEN_SCHEDULE);
-        return;
-      }
-    } else {
-      // Bedtime time: cx+100..cx+180, cy+52..cy+80
-      if (x >= cx + 100 && x <= cx + 180 && y >= cy + 52 && y <= cy + 80) {
-        editSlotIdx = 6;
-        editH = timeSlotGet(6).hour;
-        editM = timeSlotGet(6).minute;
-        switchTo(SCREEN_TIME_PICKER);
-        return;
-      }
-      // Bedtime toggle: cx+188..cx+220, cy+52..cy+80
-      if (x >= cx + 188 && x <= cx + 220 && y >= cy + 52 && y <= cy + 80) {
-        timeSlotGet(6).enabled = !timeSlotGet(6).enabled;
-        switchTo(SCREEN_SCHEDULE);
-        return;
-      }
-    }
-  }
-}
-
-// ============================================================
-// TOUCH: TIME PICKER
-// ============================================================
-static void touchTimePicker(int x, int y) {
-  // H+: 150-210, 90-125
-  if (x >= 150 && x <= 210 && y >= 90 && y <= 125) {
-    editH = (editH + 1) % 24;
-    switchTo(SCREEN_TIME_PICKER);
-    return;
-  }
-  // H-: 150-210, 165-200
-  if (x >= 150 && x <= 210 && y >= 165 && y <= 200) {
-    editH = (editH + 23) % 24;
-    switchTo(SCREEN_TIME_PICKER);
-    return;
-  }
-  // M+: 270-330, 90-125
-  if (x >= 270 && x <= 330 && y >= 90 && y <= 125) {
-    editM = (editM + 5) % 60;
-    switchTo(SCREEN_TIME_PICKER);
-    return;
-  }
-  // M-: 270-330, 165-200
-  if (x >= 270 && x <= 330 && y >= 165 && y <= 200) {
-    editM = (editM + 55) % 60;
-    switchTo(SCREEN_TIME_PICKER);
-    return;
-  }
-  // Save: 100-240, 230-275
-  if (x >= 100 && x <= 240 && y >= 230 && y <= 275) {
-    timeSlotSet(editSlotIdx, editH, editM, timeSlotGet(editSlotIdx).enabled);
-    schedulerSave();
-    switchTo(SCREEN_SCHEDULE);
-    return;
-  }
-  // Cancel: 260-400, 230-275
-  if (x >= 260 && x <= 400 && y >= 230 && y <= 275) {
-    switchTo(SCREEN_SCHEDULE);
-    return;
-  }
+// Screens that count down, move or wait on the network keep the loop awake
+bool uiCanIdle(void) {
+  if (animActive() || portalActive || wifiScanning)
+    return false;
+  return currentScreen != SCREEN_CONFIRM_DISPENSE &&
+         currentScreen != SCREEN_DISPENSING &&
+         currentScreen != SCREEN_RESULT &&
+         currentScreen != SCREEN_WIFI_PORTAL;
 }
 
-// ============================================================
-// TOUCH: MODULES
-// ============================================================
-static void touchModules(int x, int y) {
-  // Back: 5-65, 5-35
-  if (x <= 65 && y <= 40) {
-    switchTo(SCREEN_HOME);
-    return;
-  }
-  // Prev
-  if (x >= 10 && x <= 100 && y >= 295 && modPage > 0) {
-    modPage -= 3;
-    switchTo(SCREEN_MODULES);
-    return;
-  }
-  // Next
-  if (x >= 380 && x <= 470 && y >= 295 && modPage + 3 < NUM_MODULES) {
-    modPage += 3;
-    switchTo(SCREEN_MODULES);
-    return;
-  }
-  // Card tap → detail
-  for (int i = 0; i < 3; i++) {
-    int idx = modPage + i;
-    if (idx >= NUM_MODULES)
-      break;
-    int cy = 48 + i * 84;
-    if (y >= cy && y <= cy + 76 && x >= 10 && x <= 470) {
-      Serial.printf("[UI] Module %d tapped\n", idx);
-      editModIdx = idx;
-      switchTo(SCREEN_MODULE_DETAIL);
-      return;
-    }
+// After panel sleep-out: the canvas still holds the screen, so it is sent
+// whole — with the clock brought up to date first
+void uiRepaint(void) {
+  if (currentScreen == SCREEN_HOME) {
+    lastClockTick = millis();
+    patchLive(homeLive, drawHomeLive);
   }
+  dirtyAddAll();
+  presentAndWait();
 }
 
 // ============================================================
-// TOUCH: MODULE DETAIL
+// MANUAL DISPENSE SCREEN — Grid of 6 modules
+// Each card is a node that repaints itself (bg follows servo state);
+// its action button is a child.
 // ============================================================
-static void touchModuleDetail(int x, int y) {
-  MedModule &mod = moduleGet(editModIdx);
-
-  // Back: 5-65, 5-35
-  if (x <= 65 && y <= 40) {
-    switchTo(SCREEN_MODULES);
-    return;
-  }
+static void drawManualCard(int id) {
+  const Widget &w = widgetGet(id);
+  auto &lcd = canvas;
+  int i = w.arg;
+  int cx = w.x, cy = w.y, cw = w.w, ch = w.h;
+  MedModule &mod = moduleGet(i);
+  bool active = servoIsManualActive(i);
 
-  // Change name: 380-455, 58-92
-  if (x >= 380 && x <= 455 && y >= 58 && y <= 92) {
-    int cur = 0;
-    for (int i = 0; i < numPresets; i++) {
-      if (strcmp(mod.name, presetNames[i]) == 0) {
-        cur = i;
-        break;
-      }
-    }
-    cur = (cur + 1) % numPresets;
-    moduleSetName(editModIdx, presetNames[cur]);
-    switchTo(SCREEN_MODULE_DETAIL);
-    return;
-  }
+  // Card bg
+  lcd.fillRect(cx, cy, cw, ch, COL_BG);
+  lcd.fillRoundRect(cx, cy, cw, ch, 8, active ? COL_WARN : COL_CARD);
 
-  // Qty-: 180-240, 118-156
-  if (x >= 180 && x <= 240 && y >= 118 && y <= 156) {
-    if (mod.qty > 0)
-      mod.qty--;
-    switchTo(SCREEN_MODULE_DETAIL);
-    return;
-  }
-  // Qty+: 360-420, 118-156
-  if (x >= 360 && x <= 420 && y >= 118 && y <= 156) {
-    if (mod.qty < 99)
-      mod.qty++;
-    switchTo(SCREEN_MODULE_DETAIL);
-    return;
-  }
-
-  // Slot toggles (7 chips)
-  for (int s = 0; s < NUM_TIME_SLOTS; s++) {
-    int col = s % 4;
-    int row = s / 4;
-    int px = 22 + col * 112;
-    int py = 204 + row * 30;
-    if (x >= px && x <= px + 104 && y >= py && y <= py + 26) {
-      moduleToggleSlot(editModIdx, s);
-      switchTo(SCREEN_MODULE_DETAIL);
-      return;
-    }
-  }
+  // Module name
+  lcd.setFont(uiFont(FONT_BODY));
+  lcd.setTextDatum(middle_center);
+  lcd.setTextColor(active ? COL_BG : COL_PRIMARY,
+                   active ? COL_WARN : COL_CARD);
+  lcd.drawString(langModuleName(mod.name), cx + cw / 2, cy + 30);
 
-  // Save: 140-340, 272-314
-  if (x >= 140 && x <= 340 && y >= 272 && y <= 314) {
-    schedulerSave();
-    switchTo(SCREEN_MODULES);
-    return;
-  }
+  // Action button inside card
+  btn(cx + 20, cy + 60, 100, 30, tr(active ? STR_STOP : STR_DISPENSE_NOW),
+      active ? COL_DANGER : COL_PRIMARY, active ? COL_TEXT : COL_BG);
 }
 
-// ============================================================
-// MANUAL DISPENSE SCREEN — Grid of 6 modules
-// ============================================================
 static void drawManualDispense() {
   auto &lcd = canvas;
 
   // Header
   lcd.fillRect(0, 0, 480, 40, COL_DANGER);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_DANGER);
-  lcd.drawString("Manual Dispense", 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
+  lcd.drawString(tr(STR_MANUAL_DISPENSE), 240, 20);
+  backButton([](int) { switchTo(SCREEN_HOME); });
 
-  // Draw 6 modules as buttons
-  int cw = 140, ch = 100;
+  // Draw 6 modules as cards
   for (int i = 0; i < NUM_MODULES; i++) {
     int col = i % 3;
     int row = i / 3;
     int cx = 20 + col * 150;
     int cy = 60 + row * 115;
 
-    MedModule &mod = moduleGet(i);
-    bool active = servoIsManualActive(i);
-
-    // Card bg
-    lcd.fillRoundRect(cx, cy, cw, ch, 8, active ? COL_WARN : COL_CARD);
-
-    // Module name
-    lcd.setFont(&fonts::FreeSans9pt7b);
-    lcd.setTextDatum(middle_center);
-    lcd.setTextColor(active ? COL_BG : COL_PRIMARY,
-                     active ? COL_WARN : COL_CARD);
-    lcd.drawString(mod.name, cx + cw / 2, cy + 30);
-
-    // Action button inside card
-    int bx = cx + 20;
-    int by = cy + 60;
-    btn(bx, by, 100, 30, active ? "STOP" : "DISPENSE",
-        active ? COL_DANGER : COL_PRIMARY, active ? COL_TEXT : COL_BG);
-  }
-}
-
-// ============================================================
-// TOUCH: MANUAL DISPENSE
-// ============================================================
-static void touchManualDispense(int x, int y) {
-  // Back: 5-65, 5-35
-  if (x <= 65 && y <= 40) {
-    switchTo(SCREEN_HOME);
-    return;
-  }
-
-  int cw = 140, ch = 100;
-  for (int i = 0; i < NUM_MODULES; i++) {
-    int col = i % 3;
-    int row = i / 3;
-    int cx = 20 + col * 150;
-    int cy = 60 + row * 115;
-
-    // Action button inside card
-    int bx = cx + 20;
-    int by = cy + 60;
-
-    if (x >= bx && x <= bx + 100 && y >= by && y <= by + 30) {
-      if (manualCb) {
-        manualCb(i);
-        switchTo(SCREEN_MANUAL_DISPENSE); // Redraw
-      }
-      return;
-    }
+    int card = widgetAdd(cx, cy, 140, 100, nullptr, i, drawManualCard);
+    widgetAdd(
+        cx + 20, cy + 60, 100, 30,
+        [](int id) {
+          if (manualCb) {
+            manualCb(widgetArg(id));
+            widgetInvalidate(widgetGet(id).parent);
+          }
+        },
+        i, nullptr, card);
+    dynamic([&] { widgetInvalidate(card); });
   }
 }
 
@@ -1080,63 +1320,60 @@ static void drawConfirmDispense() {
 
   // Header
   lcd.fillRect(0, 0, 480, 44, COL_WARN);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_BG, COL_WARN);
-  lcd.drawString("Medicine Time!", 240, 22);
-
-  // Time Slot Info
-  lcd.setFont(&fonts::FreeSans12pt7b);
-  lcd.setTextColor(COL_PRIMARY, COL_BG);
-  char buf[64];
-  if (confirmSlotIdx >= 0) {
-    TimeSlot &ts = timeSlotGet(confirmSlotIdx);
-    sprintf(buf, "%s (%02d:%02d)", periodName[confirmSlotIdx / 2], ts.hour,
-            ts.minute);
+  lcd.drawString(tr(STR_MED_TIME), 240, 22);
+
+  // Time Slot Info + countdown timer
+  dynamic([&] {
+    lcd.setFont(uiFont(FONT_LARGE));
+    lcd.setTextColor(COL_PRIMARY, COL_BG);
+    char buf[64];
+    if (confirmSlotIdx >= 0) {
+      TimeSlot &ts = timeSlotGet(confirmSlotIdx);
+      sprintf(buf, "%s (%02d:%02d)", uiLang->periodName[confirmSlotIdx / 2],
+              ts.hour, ts.minute);
+    } else {
+      sprintf(buf, "%02d:%02d", confirmH, confirmM); // own-time rule
+    }
     lcd.drawString(buf, 240, 75);
-  }
-
-  // Countdown timer
-  long elapsed = millis() - confirmStartMs;
-  long remaining = (10 * 60 * 1000UL) - elapsed;
-  if (remaining < 0)
-    remaining = 0;
-  int rm = (remaining / 1000) / 60;
-  int rs = (remaining / 1000) % 60;
-
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextColor(COL_DANGER, COL_BG);
-  sprintf(buf, "Auto-cancel in %02d:%02d", rm, rs);
-  lcd.drawString(buf, 240, 110);
+    showLive(countdownLive, drawConfirmCountdown);
+  });
 
   // Confirm Button (Big)
   lcd.fillRoundRect(60, 140, 360, 90, 8, COL_SUCCESS);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextColor(COL_TEXT_INV, COL_SUCCESS);
-  lcd.drawString("PRESS TO DISPENSE", 240, 185);
-
-  // Cancel Button
-  btn(190, 250, 100, 40, "Cancel", COL_CARD, COL_TEXT_DIM);
-}
-
-// ============================================================
-// TOUCH: CONFIRM DISPENSE
-// ============================================================
-static void touchConfirmDispense(int x, int y) {
-  // Confirm Button (60, 140, 360, 90)
-  if (x > 60 && x < 420 && y > 140 && y < 230) {
+  lcd.drawString(tr(STR_PRESS_TO_DISPENSE), 240, 185);
+  widgetAdd(60, 140, 360, 90, [](int) {
     if (confirmCb) {
       confirmCb(confirmSlotIdx);
     } else {
       switchTo(SCREEN_HOME);
     }
-    return;
-  }
+  });
 
-  // Cancel Button (190, 250, 100, 40)
-  if (x > 190 && x < 290 && y > 250 && y < 290) {
-    switchTo(SCREEN_HOME);
-  }
+  // Cancel Button
+  button(190, 250, 100, 40, tr(STR_CANCEL), COL_CARD, COL_TEXT_DIM,
+         [](int) { switchTo(SCREEN_HOME); });
+}
+
+static void drawConfirmCountdown() {
+  long elapsed = millis() - confirmStartMs;
+  long remaining = (10 * 60 * 1000UL) - elapsed;
+  if (remaining < 0)
+    remaining = 0;
+  int rm = (remaining / 1000) / 60;
+  int rs = (remaining / 1000) % 60;
+
+  char buf[32];
+  sprintf(buf, tr(STR_AUTO_CANCEL_FMT), rm, rs);
+  canvas.setFont(uiFont(FONT_BODY));
+  canvas.setTextDatum(middle_center);
+  canvas.fillRect(140, 98, 200, 24, COL_BG);
+  canvas.setTextColor(COL_DANGER, COL_BG);
+  canvas.drawString(buf, 240, 110);
 }
 
 // ============================================================
@@ -1146,160 +1383,106 @@ static void drawWifiMenu() {
   auto &lcd = canvas;
   lcd.fillScreen(COL_BG);
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  lcd.drawString("WiFi Setup", 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
-
-  btn(40, 80, 400, 60, "1. Quick Connect (Mobile Captive Portal)", COL_PRIMARY,
-      COL_BG);
-  btn(40, 160, 400, 60, "2. Manual Connect (On-Screen Keyboard)", COL_CARD,
-      COL_TEXT);
-  btn(140, 250, 200, 40, "Forget WiFi Network", COL_DANGER, COL_TEXT_INV);
-}
-
-static void touchWifiMenu(int x, int y) {
-  if (x <= 65 && y <= 40) {
-    switchTo(SCREEN_HOME);
-    return;
-  }
-  if (x >= 40 && x <= 440 && y >= 80 && y <= 140) {
-    switchTo(SCREEN_WIFI_PORTAL);
-    return;
-  }
-  if (x >= 40 && x <= 440 && y >= 160 && y <= 220) {
-    wifiNeedsScan = true;
-    switchTo(SCREEN_WIFI_SCAN);
-    return;
-  }
-  if (x >= 140 && x <= 340 && y >= 250 && y <= 290) {
-    wifiForget();
-    switchTo(SCREEN_HOME);
-    return;
-  }
+  lcd.drawString(tr(STR_WIFI_SETUP), 240, 20);
+  backButton([](int) { switchTo(SCREEN_HOME); });
+
+  button(40, 80, 400, 60, tr(STR_QUICK_CONNECT),
+         COL_PRIMARY, COL_BG, [](int) { switchTo(SCREEN_WIFI_PORTAL); });
+  button(40, 160, 400, 60, tr(STR_MANUAL_CONNECT), COL_CARD,
+         COL_TEXT, [](int) {
+           wifiNeedsScan = true;
+           switchTo(SCREEN_WIFI_SCAN);
+         });
+  button(140, 250, 200, 40, tr(STR_FORGET_WIFI), COL_DANGER, COL_TEXT_INV,
+         [](int) {
+           wifiForget();
+           switchTo(SCREEN_HOME);
+         });
 }
 
 // ============================================================
 // WIFI PORTAL (Mobile connect)
+// No widgets: touches are ignored while the portal is running.
 // ============================================================
 static void drawWifiPortal() {
   auto &lcd = canvas;
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  lcd.drawString("Connect via Phone", 240, 20);
+  lcd.drawString(tr(STR_PORTAL_TITLE), 240, 20);
 
-  lcd.setFont(&fonts::FreeSans9pt7b);
+  lcd.setFont(uiFont(FONT_BODY));
   lcd.setTextColor(COL_TEXT, COL_BG);
-  lcd.drawString("1. Connect your phone to WiFi: Med-Dispenser", 240, 100);
-  lcd.drawString("2. A webpage will open automatically.", 240, 140);
-  lcd.drawString("3. Select your home network and enter the password.", 240,
-                 180);
+  lcd.drawString(tr(STR_PORTAL_STEP1), 240, 100);
+  lcd.drawString(tr(STR_PORTAL_STEP2), 240, 140);
+  lcd.drawString(tr(STR_PORTAL_STEP3), 240, 180);
 
   lcd.setTextColor(COL_DANGER, COL_BG);
-  lcd.drawString("Look at your phone now! (Timeout in 3 mins)", 240, 250);
-}
-
-static void touchWifiPortal(int x, int y) {
-  // Ignored while portal is running.
+  lcd.drawString(tr(STR_PORTAL_LOOK), 240, 250);
 }
 
 // ============================================================
 // WIFI SCAN
 // ============================================================
+static void rescan(int) {
+  wifiNeedsScan = true;
+  switchTo(SCREEN_WIFI_SCAN);
+}
+
+#define WIFI_ROW_H 50
+
+static void drawWifiRow(LGFX_Sprite &row, int idx) {
+  row.fillScreen(COL_BG);
+  btnOn(row, 0, 5, 390, 40, WiFi.SSID(idx).c_str(), COL_CARD, COL_TEXT);
+}
+
 static void drawWifiScan() {
   auto &lcd = canvas;
   lcd.fillScreen(COL_BG);
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  lcd.drawString("Select Network", 240, 20);
-  btn(5, 5, 60, 30, "Back", COL_CARD, COL_TEXT);
+  lcd.drawString(tr(STR_SELECT_NETWORK), 240, 20);
 
   if (wifiScanning) {
+    btn(5, 5, 60, 30, tr(STR_BACK), COL_CARD, COL_TEXT);
     lcd.setTextColor(COL_TEXT);
-    lcd.drawString("Scanning...", 240, 150);
+    lcd.drawString(tr(STR_SCANNING), 240, 150);
     return;
   }
+  backButton([](int) { switchTo(SCREEN_WIFI_MENU); });
+
   if (wifiScanCount == 0) {
     lcd.setTextColor(COL_TEXT_DIM);
-    lcd.drawString("No networks found", 240, 150);
-    btn(190, 200, 100, 40, "Rescan", COL_PRIMARY, COL_TEXT_INV);
-    return;
-  }
-
-  int startIdx = wifiScanPage * 4;
-  for (int i = 0; i < 4; i++) {
-    int idx = startIdx + i;
-    if (idx >= wifiScanCount)
-      break;
-    int y = 55 + i * 50;
-    btn(40, y, 400, 40, wifiNetworks[idx].c_str(), COL_CARD, COL_TEXT);
-  }
-
-  // Nav
-  if (wifiScanPage > 0)
-    btn(10, 270, 80, 40, "< Prev", COL_BTN, COL_TEXT);
-  if (startIdx + 4 < wifiScanCount)
-    btn(390, 270, 80, 40, "Next >", COL_BTN, COL_TEXT);
-  btn(200, 270, 80, 40, "Rescan", COL_PRIMARY, COL_TEXT_INV);
-}
-
-static void touchWifiScan(int x, int y) {
-  if (wifiScanning)
-    return;
-  if (x <= 65 && y <= 40) {
-    switchTo(SCREEN_WIFI_MENU);
-    return;
-  }
-
-  // Rescan empty
-  if (wifiScanCount == 0 && x >= 190 && x <= 290 && y >= 200 && y <= 240) {
-    wifiNeedsScan = true;
-    switchTo(SCREEN_WIFI_SCAN);
-    return;
-  }
-
-  // Nav
-  int startIdx = wifiScanPage * 4;
-  if (wifiScanPage > 0 && x >= 10 && x <= 90 && y >= 270 && y <= 310) {
-    wifiScanPage--;
-    switchTo(SCREEN_WIFI_SCAN);
-    return;
-  }
-  if (startIdx + 4 < wifiScanCount && x >= 390 && x <= 470 && y >= 270 &&
-      y <= 310) {
-    wifiScanPage++;
-    switchTo(SCREEN_WIFI_SCAN);
-    return;
-  }
-  if (wifiScanCount > 0 && x >= 200 && x <= 280 && y >= 270 && y <= 310) {
-    wifiNeedsScan = true;
-    switchTo(SCREEN_WIFI_SCAN);
+    lcd.drawString(tr(STR_NO_NETWORKS), 240, 150);
+    button(190, 200, 100, 40, tr(STR_RESCAN), COL_PRIMARY, COL_TEXT_INV,
+           rescan);
     return;
   }
 
-  // Networks
-  for (int i = 0; i < 4; i++) {
-    int idx = startIdx + i;
-    if (idx >= wifiScanCount)
-      break;
-    int by = 55 + i * 50;
-    if (x >= 40 && x <= 440 && y >= by && y <= by + 40) {
-      selectedSSID = wifiNetworks[idx];
-      inputPassword = "";
-      oskShift = false;
-      switchTo(SCREEN_WIFI_OSK);
-      return;
-    }
-  }
+  // SSID rows → password entry
+  dynamic([] {
+    listBegin(40, 50, 400, 215, WIFI_ROW_H, wifiScanCount, drawWifiRow,
+              [](int idx) {
+                selectedSSID = WiFi.SSID(idx);
+                inputPassword = "";
+                oskShift = false;
+                switchTo(SCREEN_WIFI_OSK);
+              });
+  });
+
+  button(200, 270, 80, 40, tr(STR_RESCAN), COL_PRIMARY, COL_TEXT_INV, rescan);
 }
 
 // ============================================================
 // WIFI OSK
+// Keys are children of the keyboard node: Shift repaints the keyboard,
+// every other key repaints only the input box.
 // ============================================================
 static const char *keys[4][10] = {
     {"1", "2", "3", "4", "5", "6", "7", "8", "9", "0"},
@@ -1312,25 +1495,71 @@ static const char *keysShift[4][10] = {
     {"A", "S", "D", "F", "G", "H", "J", "K", "L", ""},
     {"^", "Z", "X", "C", "V", "B", "N", "M", "DEL", ""}};
 
+static int oskInputId = WIDGET_NONE;
+
+static void drawOskInput(int id) {
+  const Widget &w = widgetGet(id);
+  canvas.fillRect(w.x, w.y, w.w, w.h, COL_BG);
+  canvas.fillRoundRect(w.x, w.y, w.w, w.h, 5, COL_CARD);
+  canvas.setFont(uiFont(FONT_LARGE));
+  canvas.setTextDatum(middle_left);
+  canvas.setTextColor(COL_TEXT, COL_CARD);
+  String disp = inputPassword + "_";
+  canvas.drawString(disp.c_str(), w.x + 10, w.y + w.h / 2);
+}
+
+// arg = row * 10 + column
+static void drawOskKey(int id) {
+  const Widget &w = widgetGet(id);
+  int r = w.arg / 10, c = w.arg % 10;
+  const char *k = oskShift ? keysShift[r][c] : keys[r][c];
+  clearWidget(w, COL_BG);
+  if (r == 3 && c == 0) { // Shift
+    btn(w.x, w.y, w.w, w.h, k, oskShift ? COL_PRIMARY : COL_BTN, COL_TEXT);
+  } else if (r == 3 && c == 8) {
+    btn(w.x, w.y, w.w, w.h, k, COL_DANGER, COL_TEXT);
+  } else {
+    btn(w.x, w.y, w.w, w.h, k, COL_BTN, COL_TEXT);
+  }
+}
+
+static void oskKeyTap(int id) {
+  const Widget &w = widgetGet(id);
+  int r = w.arg / 10, c = w.arg % 10;
+  if (r == 3 && c == 0) {
+    oskShift = !oskShift;
+    widgetInvalidate(w.parent);
+    return;
+  }
+  if (r == 3 && c == 8) {
+    if (inputPassword.length() > 0) {
+      inputPassword.remove(inputPassword.length() - 1);
+    }
+  } else if (inputPassword.length() < 30) {
+    inputPassword += oskShift ? keysShift[r][c] : keys[r][c];
+  }
+  widgetInvalidate(oskInputId);
+}
+
 static void drawWifiOSK() {
   auto &lcd = canvas;
   lcd.fillScreen(COL_BG);
   lcd.fillRect(0, 0, 480, 40, COL_PRIMARY);
-  lcd.setFont(&fonts::FreeSansBold12pt7b);
+  lcd.setFont(uiFont(FONT_TITLE));
   lcd.setTextDatum(middle_center);
   lcd.setTextColor(COL_TEXT_INV, COL_PRIMARY);
-  String title = "SSID: " + selectedSSID;
+  String title = tr(STR_SSID) + selectedSSID;
   lcd.drawString(title.substring(0, 25).c_str(), 240, 20);
-  btn(5, 5, 80, 30, "Cancel", COL_CARD, COL_TEXT);
-  btn(390, 5, 85, 30, "Connect", COL_SUCCESS, COL_TEXT_INV);
+  button(5, 5, 80, 30, tr(STR_CANCEL), COL_CARD, COL_TEXT,
+         [](int) { switchTo(SCREEN_WIFI_SCAN); });
+  button(390, 5, 85, 30, tr(STR_CONNECT), COL_SUCCESS, COL_TEXT_INV, [](int) {
+    wifiConnectManual(selectedSSID.c_str(), inputPassword.c_str());
+    switchTo(SCREEN_HOME);
+  });
 
   // Input Box
-  lcd.fillRoundRect(20, 50, 440, 40, 5, COL_CARD);
-  lcd.setFont(&fonts::FreeSans12pt7b);
-  lcd.setTextDatum(middle_left);
-  lcd.setTextColor(COL_TEXT, COL_CARD);
-  String disp = inputPassword + "_";
-  lcd.drawString(disp.c_str(), 30, 70);
+  oskInputId = widgetAdd(20, 50, 440, 40, nullptr, 0, drawOskInput);
+  dynamic([] { widgetInvalidate(oskInputId); });
 
   // Keyboard
   int startX = 10;
@@ -1338,14 +1567,12 @@ static void drawWifiOSK() {
   int keyW = 42;
   int keyH = 45;
   int gap = 4;
-  lcd.setFont(&fonts::FreeSans9pt7b);
-  lcd.setTextDatum(middle_center);
+  int board = widgetAdd(startX, startY, 460, 4 * (keyH + gap), nullptr);
 
   for (int r = 0; r < 4; r++) {
     int rowOffset = (r == 2) ? 20 : 0;
     for (int c = 0; c < 10; c++) {
-      const char *k = oskShift ? keysShift[r][c] : keys[r][c];
-      if (k[0] == '\0')
+      if (keys[r][c][0] == '\0')
         continue; // Skip empty
       int x = startX + rowOffset + c * (keyW + gap);
       int y = startY + r * (keyH + gap);
@@ -1354,66 +1581,208 @@ static void drawWifiOSK() {
       if (r == 3 && c == 8)
         w = keyW * 2 + gap; // DEL
 
-      if (r == 3 && c == 0) { // Shift
-        btn(x, y, w, keyH, k, oskShift ? COL_PRIMARY : COL_BTN, COL_TEXT);
-      } else if (r == 3 && c == 8) {
-        btn(x, y, w, keyH, k, COL_DANGER, COL_TEXT);
-      } else {
-        btn(x, y, w, keyH, k, COL_BTN, COL_TEXT);
-      }
+      widgetAdd(x, y, w, keyH, oskKeyTap, r * 10 + c, drawOskKey, board);
     }
   }
+  widgetInvalidate(board); // static: the layer variant includes Shift
 }
 
-static void touchWifiOSK(int x, int y) {
-  // Navigation
-  if (y <= 40) {
-    if (x <= 90) { // Cancel
-      switchTo(SCREEN_WIFI_SCAN);
-      return;
-    }
-    if (x >= 390) { // Connect
-      wifiConnectManual(selectedSSID.c_str(), inputPassword.c_str());
-      switchTo(SCREEN_HOME);
-      return;
-    }
+// ============================================================
+// Static layer variants — state baked into a screen's chrome
+// ============================================================
+static uint32_t screenState(Screen s) {
+  switch (s) {
+  case SCREEN_HOME: {
+    // Date line and Wi-Fi button
+    uint16_t yr;
+    uint8_t mo, dy, dow;
+    schedulerGetDate(yr, mo, dy, dow);
+    uint32_t date = ((uint32_t)yr << 16) | (mo << 8) | dy;
+    uint32_t h = layerHash(&date, sizeof(date));
+    if (!wifiIsConnected())
+      return h;
+    String ssid = wifiGetSSID();
+    return layerHash(ssid.c_str(), ssid.length(), h ^ 1);
   }
+  case SCREEN_TIME_PICKER:
+    return editSlotIdx; // title
+  case SCREEN_MODULE_DETAIL:
+    return editModIdx; // title
+  case SCREEN_WIFI_SCAN:
+    return wifiScanning ? 1 : (wifiScanCount == 0 ? 2 : 0);
+  case SCREEN_WIFI_OSK:
+    return layerHash(&oskShift, sizeof(oskShift),
+                     layerHash(selectedSSID.c_str(), selectedSSID.length()));
+  case SCREEN_RESULT:
+    return resultOk;
+  default:
+    return 0;
+  }
+}
 
-  // Keyboard Touch
-  int startX = 10;
-  int startY = 100;
-  int keyW = 42;
-  int keyH = 45;
-  int gap = 4;
+// Every screen's chrome is in the current language
+static uint32_t screenVariant(Screen s) {
+  uint8_t lang = langGet();
+  return layerHash(&lang, sizeof(lang), screenState(s));
+}
 
-  for (int r = 0; r < 4; r++) {
-    int rowOffset = (r == 2) ? 20 : 0;
-    for (int c = 0; c < 10; c++) {
-      int px = startX + rowOffset + c * (keyW + gap);
-      int py = startY + r * (keyH + gap);
-      int w = keyW;
-      if (r == 3 && c == 8)
-        w = keyW * 2 + gap; // DEL
+// ============================================================
+// Language switch — swaps the string and font tables and repaints
+// ============================================================
+static void setLanguage(Lang lang) {
+  langSet(lang);
+#if UI_CANVAS_BPP == 16
+  glyphWarm(uiFont(FONT_BODY), "0123456789:", COL_DANGER, COL_BG);
+#endif
+  switchTo(currentScreen);
+}
 
-      const char *k = oskShift ? keysShift[r][c] : keys[r][c];
-      if (k[0] == '\0')
-        continue;
+static void langCommand(const char *args) {
+  if (strcmp(args, "en") == 0)
+    setLanguage(LANG_EN);
+  else if (strcmp(args, "th") == 0)
+    setLanguage(LANG_TH);
+  else if (*args)
+    Serial.println("usage: lang [en|th]");
+  Serial.printf("[Lang] %s\n", uiLang->name);
+}
 
-      if (x >= px && x <= px + w && y >= py && y <= py + keyH) {
-        if (r == 3 && c == 0) {
-          oskShift = !oskShift;
-        } else if (r == 3 && c == 8) {
-          if (inputPassword.length() > 0) {
-            inputPassword.remove(inputPassword.length() - 1);
-          }
-        } else {
-          if (inputPassword.length() < 30) {
-            inputPassword += k;
-          }
-        }
-        switchTo(SCREEN_WIFI_OSK); // Redraw
-        return;
-      }
+// ============================================================
+// Render bench + golden frames (serial console)
+// Screens are drawn into the canvas without presenting; the screen
+// that was showing is re-rendered afterwards.
+//   bench [n]          one full render (layer dropped) + n cached renders
+//   golden save|check  hash of each screen's static layer, kept in NVS
+//                      with its variant; a different variant (other date,
+//                      Wi-Fi network, ...) is skipped rather than failed
+// The hashes only compare a device with its own earlier `golden save`.
+// Reference images rendered on the host are checked by the render tests
+// (test/test_ui_render, see the Tests section of README.md).
+// ============================================================
+static Screen renderPrev;
+static int savedSlotIdx, savedModIdx;
+
+bool uiRenderBegin(void) {
+  if (uiIsAnimating() || servoIsBusy() || portalActive || wifiScanning) {
+    Serial.println("[Bench] UI busy, try again when idle");
+    return false;
+  }
+  displayWait(); // nothing may stream from the canvas while it is borrowed
+  renderPrev = currentScreen;
+  renderQuiet = true;
+  // The picker and module detail draw the slot / module being edited,
+  // which is -1 until one has been opened: borrow slot / module 0
+  savedSlotIdx = editSlotIdx;
+  savedModIdx = editModIdx;
+  if (editSlotIdx < 0)
+    editSlotIdx = 0;
+  if (editModIdx < 0)
+    editModIdx = 0;
+  return true;
+}
+
+void uiRender(Screen s, bool full) {
+  if (full)
+    layerInvalidate(s);
+  renderScreen(s);
+}
+
+uint16_t uiCanvasPixel(int x, int y) { return canvas.readPixel(x, y); }
+
+void uiRenderEnd(void) {
+  editSlotIdx = savedSlotIdx;
+  editModIdx = savedModIdx;
+  renderQuiet = false;
+  switchTo(renderPrev);
+}
+
+static void benchCommand(const char *args) {
+  if (!uiRenderBegin())
+    return;
+  int n = atoi(args);
+  if (n <= 0)
+    n = 20;
+  uint32_t mhz = ESP.getCpuFreqMHz();
+
+  Serial.printf("[Bench] 1 full + %d cached renders per screen\n", n);
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    Screen s = (Screen)i;
+    uint32_t t = profStamp();
+    uiRender(s, true);
+    uint32_t full = (profStamp() - t) / mhz;
+
+    uint32_t total = 0, worst = 0;
+    for (int k = 0; k < n; k++) {
+      t = profStamp();
+      uiRender(s, false);
+      uint32_t us = (profStamp() - t) / mhz;
+      total += us;
+      if (us > worst)
+        worst = us;
+    }
+    Serial.printf("  %-14s full %6u us  cached avg %6u us  max %6u us\n",
+                  screenNames[s], (unsigned)full, (unsigned)(total / n),
+                  (unsigned)worst);
+  }
+  uiRenderEnd();
+}
+
+// Static pass only: chrome without clock, values or lists
+static uint32_t staticFrameHash(Screen s) {
+  canvas.setLayerPass(PASS_STATIC);
+  buildScreen(s);
+  canvas.setLayerPass(PASS_FULL);
+  return layerHash(canvas.getBuffer(), LAYER_BYTES);
+}
+
+static void goldenCommand(const char *args) {
+  bool save = strcmp(args, "save") == 0;
+  if (!save && strcmp(args, "check") != 0) {
+    Serial.println("usage: golden save|check");
+    return;
+  }
+  Preferences prefs;
+  if (!prefs.begin("golden", !save)) {
+    Serial.println("[Golden] No stored hashes — run 'golden save' first");
+    return;
+  }
+  if (!uiRenderBegin()) {
+    prefs.end();
+    return;
+  }
+  int passed = 0, failed = 0, skipped = 0;
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    Screen s = (Screen)i;
+    uint32_t variant = screenVariant(s);
+    uint32_t hash = staticFrameHash(s);
+    char hk[6], vk[6];
+    sprintf(hk, "h%d", i);
+    sprintf(vk, "v%d", i);
+
+    if (save) {
+      prefs.putUInt(hk, hash);
+      prefs.putUInt(vk, variant);
+    } else if (!prefs.isKey(hk)) {
+      Serial.printf("  %-14s no golden\n", screenNames[s]);
+      skipped++;
+    } else if (prefs.getUInt(vk) != variant) {
+      Serial.printf("  %-14s skipped (state differs from golden)\n",
+                    screenNames[s]);
+      skipped++;
+    } else if (prefs.getUInt(hk) != hash) {
+      Serial.printf("  %-14s MISMATCH %08lx != %08lx\n", screenNames[s],
+                    (unsigned long)hash, (unsigned long)prefs.getUInt(hk));
+      failed++;
+    } else {
+      passed++;
     }
   }
+  prefs.end();
+  uiRenderEnd();
+
+  if (save)
+    Serial.printf("[Golden] Saved %d screens\n", SCREEN_COUNT);
+  else
+    Serial.printf("[Golden] %d ok, %d mismatched, %d skipped\n", passed,
+                  failed, skipped);
 }
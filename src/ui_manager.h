@@ -16,8 +16,9 @@ enum Screen {
   SCREEN_WIFI_SCAN,        // Show available networks
   SCREEN_WIFI_OSK,         // On-Screen Keyboard for password
   SCREEN_WIFI_PORTAL,      // Showing instructions for Captive Portal
-  SCREEN_DISPENSING,
-  SCREEN_RESULT
+  SCREEN_DISPENSING,       // Dots animation while one module's servo runs
+  SCREEN_RESULT,           // Result badge, then wipes back to home
+  SCREEN_COUNT             // Number of screens (not a screen)
 };
 
 // ============================================================
@@ -25,9 +26,21 @@ enum Screen {
 // ============================================================
 void uiSetup(void);
 void uiLoop(void);
-void uiShowDispensing(int moduleIndex);
-void uiShowResult(int timeSlotIndex, bool success);
+void uiShowDispensing(int moduleIndex); // non-blocking, ~1.3 s animation
+void uiShowResult(int timeSlotIndex, bool success); // returns home by itself
+bool uiIsAnimating(void);
+bool uiCanIdle(void);  // nothing on screen needs frames or attention
+void uiRepaint(void);  // whole frame to the panel, waits until it is there
 void uiShowConfirmDispense(int timeSlotIndex);
+bool uiConfirmPending(void); // the confirmation screen is up
+
+// Off-screen rendering (bench, golden checks, host render tests): the
+// canvas is borrowed, screens are drawn into it without being presented,
+// and the screen that was showing is put back at the end
+bool uiRenderBegin(void);             // false while the UI is busy
+void uiRender(Screen s, bool full);   // full: drop its cached layer first
+uint16_t uiCanvasPixel(int x, int y); // RGB565 at any UI_CANVAS_BPP
+void uiRenderEnd(void);
 
 // Callback for manual dispense
 typedef void (*ManualDispenseCallback)(int moduleIndex);
@@ -0,0 +1,253 @@
+#include "ui_strings.h"
+#include "font_data.h"
+#include <Preferences.h>
+
+// Thai faces come from build_fonts.py when their sources are present;
+// without them the Thai table draws with the Latin faces
+#ifdef FONT_TH16
+#define TH_FONTS FONT_TH14, FONT_TH16, FONT_TH24, FONT_TH24
+#else
+#define TH_FONTS                                                           \
+  &fonts::Font2, &fonts::FreeSans9pt7b, &fonts::FreeSans12pt7b,            \
+      &fonts::FreeSansBold12pt7b
+#endif
+
+// ============================================================
+// Tables — order follows StrId / FontRole
+// ============================================================
+static constexpr LangTable langs[LANG_COUNT] = {
+    // English
+    {"English",
+     {
+        "Medicine Dispenser", // STR_TITLE
+        "Back", // STR_BACK
+        "Save", // STR_SAVE
+        "Cancel", // STR_CANCEL
+        "ON", // STR_ON
+        "OFF", // STR_OFF
+        "Schedule: ON", // STR_SCHEDULE_ON
+        "Schedule: OFF", // STR_SCHEDULE_OFF
+        "Schedule", // STR_SCHEDULE
+        "Modules", // STR_MODULES
+        "Dispense", // STR_DISPENSE
+        "Auto:", // STR_AUTO
+        "WiFi: Disconnected", // STR_WIFI_DISCONNECTED
+        "Next: %s  %02d:%02d", // STR_NEXT_FMT
+        "No upcoming schedule", // STR_NO_UPCOMING
+        "Before", // STR_BEFORE
+        "After", // STR_AFTER
+        "Time", // STR_TIME
+        "Set Time - %s", // STR_SET_TIME_FMT
+        "Hour", // STR_HOUR
+        "Min", // STR_MIN
+        "Medicine Modules", // STR_MED_MODULES
+        "Module %d", // STR_MODULE_FMT
+        "Name:", // STR_NAME
+        "Change", // STR_CHANGE
+        "Qty:", // STR_QTY
+        "Dispense at:", // STR_DISPENSE_AT
+        "Dispensing...", // STR_DISPENSING
+        "Module %d: %s", // STR_MODULE_NAME_FMT
+        "Dispensed!", // STR_DISPENSED
+        "Error!", // STR_ERROR
+        "Returning home...", // STR_RETURNING
+        "STOP", // STR_STOP
+        "DISPENSE", // STR_DISPENSE_NOW
+        "Manual Dispense", // STR_MANUAL_DISPENSE
+        "Medicine Time!", // STR_MED_TIME
+        "PRESS TO DISPENSE", // STR_PRESS_TO_DISPENSE
+        "Auto-cancel in %02d:%02d", // STR_AUTO_CANCEL_FMT
+        "WiFi Setup", // STR_WIFI_SETUP
+        "1. Quick Connect (Mobile Captive Portal)", // STR_QUICK_CONNECT
+        "2. Manual Connect (On-Screen Keyboard)", // STR_MANUAL_CONNECT
+        "Forget WiFi Network", // STR_FORGET_WIFI
+        "Connect via Phone", // STR_PORTAL_TITLE
+        "1. Connect your phone to WiFi: Med-Dispenser", // STR_PORTAL_STEP1
+        "2. A webpage will open automatically.", // STR_PORTAL_STEP2
+        // STR_PORTAL_STEP3
+        "3. Select your home network and enter the password.",
+        "Look at your phone now! (Timeout in 3 mins)", // STR_PORTAL_LOOK
+        "Select Network", // STR_SELECT_NETWORK
+        "Scanning...", // STR_SCANNING
+        "No networks found", // STR_NO_NETWORKS
+        "Rescan", // STR_RESCAN
+        "Connect", // STR_CONNECT
+        "SSID: ", // STR_SSID
+     },
+     {
+        "M.Bf", "M.Af", "N.Bf", "N.Af", "E.Bf", "E.Af", "Bed",
+     },
+     {
+        "Morning", "Noon", "Evening", "Bedtime",
+     },
+     {
+        "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat",
+     },
+     {
+        "Slot 1", "Slot 2", "Slot 3", "Slot 4", "Slot 5", "Slot 6",
+        "Paracetamol", "Vitamin C", "Antacid", "Cough Med", "Allergy",
+        "Antibiotic", "Ibuprofen", "Omeprazole",
+     },
+     {&fonts::Font2, &fonts::FreeSans9pt7b, &fonts::FreeSans12pt7b,
+      &fonts::FreeSansBold12pt7b}},
+    // Thai
+    {"ไทย",
+     {
+        "ระบบจ่ายยาอัตโนมัติ", // STR_TITLE
+        "กลับ", // STR_BACK
+        "บันทึก", // STR_SAVE
+        "ยกเลิก", // STR_CANCEL
+        "เปิด", // STR_ON
+        "ปิด", // STR_OFF
+        "ตั้งเวลา: เปิด", // STR_SCHEDULE_ON
+        "ตั้งเวลา: ปิด", // STR_SCHEDULE_OFF
+        "ตารางเวลา", // STR_SCHEDULE
+        "โมดูลยา", // STR_MODULES
+        "จ่ายยา", // STR_DISPENSE
+        "ออโต้:", // STR_AUTO
+        "WiFi: ไม่ได้เชื่อมต่อ", // STR_WIFI_DISCONNECTED
+        "คิวถัดไป: %s  %02d:%02d", // STR_NEXT_FMT
+        "ไม่มีตารางจ่ายยา", // STR_NO_UPCOMING
+        "ก่อนอาหาร", // STR_BEFORE
+        "หลังอาหาร", // STR_AFTER
+        "เวลา", // STR_TIME
+        "ตั้งเวลา - %s", // STR_SET_TIME_FMT
+        "ชั่วโมง", // STR_HOUR
+        "นาที", // STR_MIN
+        "จัดการโมดูลยา", // STR_MED_MODULES
+        "ตลับยาที่ %d", // STR_MODULE_FMT
+        "ชื่อยา:", // STR_NAME
+        "เปลี่ยน", // STR_CHANGE
+        "จำนวน:", // STR_QTY
+        "จ่ายเวลา:", // STR_DISPENSE_AT
+        "กำลังทำงาน...", // STR_DISPENSING
+        "ตลับที่ %d: %s", // STR_MODULE_NAME_FMT
+        "จ่ายยาสำเร็จ!", // STR_DISPENSED
+        "เกิดข้อผิดพลาด!", // STR_ERROR
+        "กำลังกลับหน้าหลัก...", // STR_RETURNING
+        "หยุด", // STR_STOP
+        "จ่ายยา", // STR_DISPENSE_NOW
+        "สั่งจ่ายยาแมนนวล", // STR_MANUAL_DISPENSE
+        "ถึงเวลาทานยา!", // STR_MED_TIME
+        "กดเพื่อจ่ายยา", // STR_PRESS_TO_DISPENSE
+        "ยกเลิกอัตโนมัติใน %02d:%02d", // STR_AUTO_CANCEL_FMT
+        "ตั้งค่า WiFi", // STR_WIFI_SETUP
+        "1. เชื่อมต่อด่วน (ผ่านมือถือ)", // STR_QUICK_CONNECT
+        "2. เชื่อมต่อเอง (แป้นพิมพ์บนจอ)", // STR_MANUAL_CONNECT
+        "ลืมเครือข่าย WiFi", // STR_FORGET_WIFI
+        "เชื่อมต่อผ่านมือถือ", // STR_PORTAL_TITLE
+        "1. เชื่อมมือถือกับ WiFi: Med-Dispenser", // STR_PORTAL_STEP1
+        "2. หน้าเว็บจะเปิดขึ้นเอง", // STR_PORTAL_STEP2
+        "3. เลือกเครือข่ายบ้านแล้วใส่รหัสผ่าน", // STR_PORTAL_STEP3
+        "ดูที่มือถือได้เลย! (หมดเวลาใน 3 นาที)", // STR_PORTAL_LOOK
+        "เลือกเครือข่าย", // STR_SELECT_NETWORK
+        "กำลังค้นหา...", // STR_SCANNING
+        "ไม่พบเครือข่าย", // STR_NO_NETWORKS
+        "ค้นหาใหม่", // STR_RESCAN
+        "เชื่อมต่อ", // STR_CONNECT
+        "SSID: ", // STR_SSID
+     },
+     {
+        "เช้า.ก", "เช้า.ห", "เที่ยง.ก", "เที่ยง.ห", "เย็น.ก", "เย็น.ห",
+        "ก่อนนอน",
+     },
+     {
+        "เช้า", "กลางวัน", "เย็น", "ก่อนนอน",
+     },
+     {
+        "อา.", "จ.", "อ.", "พ.", "พฤ.", "ศ.", "ส.",
+     },
+     {
+        "ช่อง 1", "ช่อง 2", "ช่อง 3", "ช่อง 4", "ช่อง 5", "ช่อง 6", "พาราฯ",
+        "วิตามินซี", "ยาแก้ปวดท้อง", "ยาแก้ไอ", "ยาแก้แพ้", "ยาฆ่าเชื้อ",
+        "ไอบูโพรเฟน", "ยาลดกรด",
+     },
+     {TH_FONTS}}};
+
+const LangTable *uiLang = &langs[LANG_EN];
+
+// ============================================================
+// Language
+// ============================================================
+static Lang current = LANG_EN;
+static void widthCacheClear();
+
+void langSetup(void) {
+  Preferences prefs;
+  prefs.begin("ui", true);
+  uint8_t saved = prefs.getUChar("lang", LANG_EN);
+  prefs.end();
+  current = saved < LANG_COUNT ? (Lang)saved : LANG_EN;
+  uiLang = &langs[current];
+  Serial.printf("[Lang] %s\n", uiLang->name);
+}
+
+Lang langGet(void) { return current; }
+
+void langSet(Lang lang) {
+  if (lang >= LANG_COUNT || lang == current)
+    return;
+  current = lang;
+  uiLang = &langs[lang];
+  widthCacheClear();
+
+  Preferences prefs;
+  prefs.begin("ui", false);
+  prefs.putUChar("lang", lang);
+  prefs.end();
+  Serial.printf("[Lang] Switched to %s\n", uiLang->name);
+}
+
+// ============================================================
+// Medicine presets
+// ============================================================
+const char *langPresetKey(int i) { return langs[LANG_EN].preset[i]; }
+
+int langPresetFind(const char *name) {
+  for (int l = 0; l < LANG_COUNT; l++)
+    for (int i = 0; i < NUM_PRESETS; i++)
+      if (strcmp(name, langs[l].preset[i]) == 0)
+        return i;
+  return -1;
+}
+
+const char *langModuleName(const char *name) {
+  int i = langPresetFind(name);
+  return i >= 0 ? uiLang->preset[i] : name;
+}
+
+// ============================================================
+// Text width cache
+// Direct-mapped on an FNV-1a hash of the string; an entry matches on
+// font, length and hash. Cleared on a language switch so the slots go
+// to the new language's strings.
+// ============================================================
+#define WIDTH_CACHE_SLOTS 64
+
+struct WidthEntry {
+  const lgfx::IFont *font;
+  uint32_t hash;
+  uint16_t len;
+  int16_t width;
+};
+static WidthEntry widthCache[WIDTH_CACHE_SLOTS];
+
+static void widthCacheClear() { memset(widthCache, 0, sizeof(widthCache)); }
+
+int textWidthCached(lgfx::LGFXBase &gfx, const char *str) {
+  uint32_t h = 2166136261u;
+  size_t len = 0;
+  for (const char *p = str; *p; p++, len++)
+    h = (h ^ (uint8_t)*p) * 16777619u;
+
+  const lgfx::IFont *font = gfx.getFont();
+  WidthEntry &e = widthCache[(h ^ (uintptr_t)font) % WIDTH_CACHE_SLOTS];
+  if (e.font == font && e.hash == h && e.len == len)
+    return e.width;
+  int w = gfx.textWidth(str);
+  e.font = font;
+  e.hash = h;
+  e.len = len;
+  e.width = w;
+  return w;
+}
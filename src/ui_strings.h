@@ -0,0 +1,112 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+#include <LovyanGFX.hpp>
+
+// ============================================================
+// UI strings and fonts, per language
+// Every string the UI draws lives in a constexpr table per language,
+// together with the fonts that can render it. Switching language swaps
+// one table pointer (persisted in NVS) — nothing is allocated.
+// Medicine names are stored in the scheduler by their English preset
+// key and translated when drawn.
+// ============================================================
+enum Lang : uint8_t { LANG_EN, LANG_TH, LANG_COUNT };
+
+enum FontRole : uint8_t {
+  FONT_SMALL, // chips, labels
+  FONT_BODY,  // buttons, body text
+  FONT_LARGE, // subtitles, input box
+  FONT_TITLE, // headers
+  FONT_ROLE_COUNT
+};
+
+enum StrId : uint8_t {
+  STR_TITLE,
+  STR_BACK,
+  STR_SAVE,
+  STR_CANCEL,
+  STR_ON,
+  STR_OFF,
+  STR_SCHEDULE_ON,
+  STR_SCHEDULE_OFF,
+  STR_SCHEDULE,
+  STR_MODULES,
+  STR_DISPENSE,
+  STR_AUTO,
+  STR_WIFI_DISCONNECTED,
+  STR_NEXT_FMT,      // slot, hour, minute
+  STR_NO_UPCOMING,
+  STR_BEFORE,
+  STR_AFTER,
+  STR_TIME,
+  STR_SET_TIME_FMT,  // slot
+  STR_HOUR,
+  STR_MIN,
+  STR_MED_MODULES,
+  STR_MODULE_FMT,    // number
+  STR_NAME,
+  STR_CHANGE,
+  STR_QTY,
+  STR_DISPENSE_AT,
+  STR_DISPENSING,
+  STR_MODULE_NAME_FMT, // number, name
+  STR_DISPENSED,
+  STR_ERROR,
+  STR_RETURNING,
+  STR_STOP,
+  STR_DISPENSE_NOW,
+  STR_MANUAL_DISPENSE,
+  STR_MED_TIME,
+  STR_PRESS_TO_DISPENSE,
+  STR_AUTO_CANCEL_FMT, // minutes, seconds
+  STR_WIFI_SETUP,
+  STR_QUICK_CONNECT,
+  STR_MANUAL_CONNECT,
+  STR_FORGET_WIFI,
+  STR_PORTAL_TITLE,
+  STR_PORTAL_STEP1,
+  STR_PORTAL_STEP2,
+  STR_PORTAL_STEP3,
+  STR_PORTAL_LOOK,
+  STR_SELECT_NETWORK,
+  STR_SCANNING,
+  STR_NO_NETWORKS,
+  STR_RESCAN,
+  STR_CONNECT,
+  STR_SSID,
+  STR_COUNT
+};
+
+#define NUM_PERIODS 4
+#define NUM_PRESETS 14
+
+struct LangTable {
+  const char *name; // in its own language, for the switch button
+  const char *str[STR_COUNT];
+  const char *slotShort[NUM_TIME_SLOTS];
+  const char *periodName[NUM_PERIODS];
+  const char *dayName[7]; // Sunday first
+  const char *preset[NUM_PRESETS];
+  const lgfx::IFont *font[FONT_ROLE_COUNT];
+};
+
+extern const LangTable *uiLang; // current language
+
+inline const char *tr(StrId id) { return uiLang->str[id]; }
+inline const lgfx::IFont *uiFont(FontRole role) { return uiLang->font[role]; }
+
+// --- Language ---
+void langSetup(void); // loads the saved language
+Lang langGet(void);
+void langSet(Lang lang); // swaps tables, clears the width cache, saves
+
+// --- Medicine presets ---
+const char *langPresetKey(int i); // stored name (English)
+int langPresetFind(const char *name); // in any language, or -1
+const char *langModuleName(const char *name); // name as shown
+
+// --- Text measurement ---
+// gfx.textWidth() with gfx's current font, cached by font and string
+// content, so layout and damage tracking don't re-walk the glyphs
+int textWidthCached(lgfx::LGFXBase &gfx, const char *str);
@@ -0,0 +1,107 @@
+#include "widget.h"
+
+// ============================================================
+// Node storage + hit grid
+// ============================================================
+#define GRID_COLS ((LCD_WIDTH + WIDGET_CELL - 1) / WIDGET_CELL)
+#define GRID_ROWS ((LCD_HEIGHT + WIDGET_CELL - 1) / WIDGET_CELL)
+
+static Widget widgets[MAX_WIDGETS];
+static int numWidgets = 0;
+static int8_t grid[GRID_ROWS][GRID_COLS][WIDGET_CELL_SLOTS];
+
+void widgetsReset(void) {
+  numWidgets = 0;
+  memset(grid, WIDGET_NONE, sizeof(grid));
+}
+
+// Reference an interactive node from every cell it overlaps. Later nodes
+// sit on top, so a full cell evicts its oldest entry.
+static void indexWidget(int id) {
+  const Widget &w = widgets[id];
+  int c0 = w.x / WIDGET_CELL, c1 = (w.x + w.w) / WIDGET_CELL;
+  int r0 = w.y / WIDGET_CELL, r1 = (w.y + w.h) / WIDGET_CELL;
+  if (c0 < 0)
+    c0 = 0;
+  if (r0 < 0)
+    r0 = 0;
+  if (c1 >= GRID_COLS)
+    c1 = GRID_COLS - 1;
+  if (r1 >= GRID_ROWS)
+    r1 = GRID_ROWS - 1;
+
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      int8_t *cell = grid[r][c];
+      int k = 0;
+      while (k < WIDGET_CELL_SLOTS && cell[k] != WIDGET_NONE)
+        k++;
+      if (k == WIDGET_CELL_SLOTS) {
+        memmove(cell, cell + 1, WIDGET_CELL_SLOTS - 1);
+        k = WIDGET_CELL_SLOTS - 1;
+      }
+      cell[k] = id;
+    }
+  }
+}
+
+int widgetAdd(int x, int y, int w, int h, WidgetHandler onTap, int arg,
+              WidgetDraw draw, int parent) {
+  if (numWidgets >= MAX_WIDGETS) {
+    Serial.println("[Widget] Tree full");
+    return WIDGET_NONE;
+  }
+  int id = numWidgets++;
+  widgets[id] = {(int16_t)x, (int16_t)y, (int16_t)w, (int16_t)h,
+                 (int16_t)parent, arg, onTap, draw, 0};
+  if (onTap)
+    indexWidget(id);
+  return id;
+}
+
+int widgetCount(void) { return numWidgets; }
+const Widget &widgetGet(int id) { return widgets[id % MAX_WIDGETS]; }
+int widgetArg(int id) { return widgets[id % MAX_WIDGETS].arg; }
+
+void widgetSetFlags(int id, uint8_t flags) {
+  if (id >= 0 && id < numWidgets)
+    widgets[id].flags = flags;
+}
+
+// ============================================================
+// Hit test — one cell lookup, then at most WIDGET_CELL_SLOTS bound checks
+// ============================================================
+int widgetHitTest(int x, int y) {
+  if (x < 0 || y < 0 || x >= LCD_WIDTH || y >= LCD_HEIGHT)
+    return WIDGET_NONE;
+  const int8_t *cell = grid[y / WIDGET_CELL][x / WIDGET_CELL];
+  for (int k = WIDGET_CELL_SLOTS - 1; k >= 0; k--) {
+    int id = cell[k];
+    if (id == WIDGET_NONE)
+      continue;
+    const Widget &w = widgets[id];
+    if (x >= w.x && x <= w.x + w.w && y >= w.y && y <= w.y + w.h)
+      return id;
+  }
+  return WIDGET_NONE;
+}
+
+bool widgetDispatch(int x, int y) {
+  int id = widgetHitTest(x, y);
+  if (id == WIDGET_NONE)
+    return false;
+  widgets[id].onTap(id);
+  return true;
+}
+
+// ============================================================
+void widgetInvalidate(int id) {
+  if (id < 0 || id >= numWidgets)
+    return;
+  if (widgets[id].draw)
+    widgets[id].draw(id);
+  for (int i = id + 1; i < numWidgets; i++) {
+    if (widgets[i].parent == id)
+      widgetInvalidate(i);
+  }
+}
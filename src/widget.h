@@ -0,0 +1,45 @@
+#pragma once
+#include "config.h"
+#include <Arduino.h>
+
+// ============================================================
+// Retained widget tree + spatial hit-test index
+// Screens register their nodes while drawing, so geometry lives in one
+// place; touch dispatch resolves through a fixed grid in O(1).
+// ============================================================
+#define MAX_WIDGETS 80
+#define WIDGET_CELL 20      // hit-grid cell size (px)
+#define WIDGET_CELL_SLOTS 4 // interactive nodes referenced per cell
+#define WIDGET_NONE -1
+
+// Widget flags
+#define WIDGET_REPEAT 0x01 // fires on press and auto-repeats while held
+
+typedef void (*WidgetHandler)(int id);
+typedef void (*WidgetDraw)(int id);
+
+struct Widget {
+  int16_t x, y, w, h;
+  int16_t parent;      // enclosing node, WIDGET_NONE = screen root
+  int arg;             // slot / module / key index for the callbacks
+  WidgetHandler onTap; // nullptr = container or display-only node
+  WidgetDraw draw;     // nullptr = static, repainted with the screen
+  uint8_t flags;       // WIDGET_* flags
+};
+
+// --- Layout ---
+void widgetsReset(void); // drop the tree (called on screen switch)
+int widgetAdd(int x, int y, int w, int h, WidgetHandler onTap, int arg = 0,
+              WidgetDraw draw = nullptr, int parent = WIDGET_NONE);
+int widgetCount(void);
+const Widget &widgetGet(int id);
+int widgetArg(int id);
+void widgetSetFlags(int id, uint8_t flags);
+
+// --- Touch ---
+int widgetHitTest(int x, int y); // topmost interactive node or WIDGET_NONE
+bool widgetDispatch(int x, int y);
+
+// --- Redraw ---
+// Repaints the node (if it has a draw callback) and then its children
+void widgetInvalidate(int id);
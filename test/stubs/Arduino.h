@@ -0,0 +1,72 @@
+#pragma once
+// ============================================================
+// Host stand-in for the Arduino core — just what the modules under
+// test use (env:native). Serial output goes to stdout.
+// ============================================================
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define IRAM_ATTR
+
+// A test that needs repeatable output (rendered countdowns) stops the
+// clock: millis() then returns fakeMillis
+inline bool fakeClock = false;
+inline unsigned long fakeMillis = 0;
+
+inline unsigned long millis(void) {
+  using namespace std::chrono;
+  static const steady_clock::time_point t0 = steady_clock::now();
+  if (fakeClock)
+    return fakeMillis;
+  return duration_cast<milliseconds>(steady_clock::now() - t0).count();
+}
+
+class String {
+  std::string s;
+
+public:
+  String(const char *c = "") : s(c ? c : "") {}
+  const char *c_str() const { return s.c_str(); }
+  unsigned length() const { return s.size(); }
+  String substring(unsigned from, unsigned to) const {
+    return s.substr(from, to - from).c_str();
+  }
+  void remove(unsigned from) { s.erase(from); }
+  String &operator+=(const char *c) {
+    s += c;
+    return *this;
+  }
+  friend String operator+(const String &a, const char *b) {
+    String r = a;
+    return r += b;
+  }
+  friend String operator+(const char *a, const String &b) {
+    return String(a) += b.c_str();
+  }
+};
+
+class HardwareSerial {
+public:
+  int printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    va_list a;
+    va_start(a, fmt);
+    int n = vprintf(fmt, a);
+    va_end(a);
+    return n;
+  }
+  void println(const char *s = "") { puts(s); }
+};
+inline HardwareSerial Serial;
+
+class EspClass {
+public:
+  uint32_t getCycleCount(void) { return millis() * 1000; } // 1 MHz
+  uint32_t getCpuFreqMHz(void) { return 1; }
+};
+inline EspClass ESP;
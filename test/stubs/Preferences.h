@@ -0,0 +1,59 @@
+#pragma once
+// ============================================================
+// Host stand-in for NVS Preferences: namespaces in memory, gone when the
+// test program exits
+// ============================================================
+#include <Arduino.h>
+#include <map>
+#include <string>
+
+class Preferences {
+  std::string ns;
+  static std::map<std::string, std::string> &store(void) {
+    static std::map<std::string, std::string> m;
+    return m;
+  }
+  std::string key(const char *k) const { return ns + "/" + k; }
+
+public:
+  bool begin(const char *name, bool readOnly = false) {
+    (void)readOnly;
+    ns = name;
+    return true;
+  }
+  void end(void) {}
+  bool remove(const char *k) { return store().erase(key(k)) != 0; }
+  size_t putBytes(const char *k, const void *v, size_t len) {
+    store()[key(k)].assign((const char *)v, len);
+    return len;
+  }
+  size_t getBytes(const char *k, void *buf, size_t maxLen) {
+    auto it = store().find(key(k));
+    if (it == store().end() || it->second.size() > maxLen)
+      return 0;
+    memcpy(buf, it->second.data(), it->second.size());
+    return it->second.size();
+  }
+  size_t putString(const char *k, const char *v) {
+    return putBytes(k, v, strlen(v) + 1);
+  }
+  String getString(const char *k, String def = String()) {
+    auto it = store().find(key(k));
+    return it == store().end() ? def : String(it->second.c_str());
+  }
+  bool isKey(const char *k) { return store().count(key(k)) != 0; }
+  size_t putUChar(const char *k, uint8_t v) {
+    return putBytes(k, &v, sizeof(v));
+  }
+  uint8_t getUChar(const char *k, uint8_t def = 0) {
+    uint8_t v;
+    return getBytes(k, &v, sizeof(v)) == sizeof(v) ? v : def;
+  }
+  size_t putUInt(const char *k, uint32_t v) {
+    return putBytes(k, &v, sizeof(v));
+  }
+  uint32_t getUInt(const char *k, uint32_t def = 0) {
+    uint32_t v;
+    return getBytes(k, &v, sizeof(v)) == sizeof(v) ? v : def;
+  }
+};
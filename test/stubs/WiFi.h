@@ -0,0 +1,17 @@
+#pragma once
+// ============================================================
+// Host stand-in for the Wi-Fi driver: the scan results a test sets in
+// fakeNetworks, never connected
+// ============================================================
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+inline std::vector<std::string> fakeNetworks;
+
+class WiFiClass {
+public:
+  int scanNetworks(void) { return (int)fakeNetworks.size(); }
+  String SSID(int i) { return String(fakeNetworks.at(i).c_str()); }
+};
+inline WiFiClass WiFi;
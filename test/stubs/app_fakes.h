@@ -0,0 +1,26 @@
+#pragma once
+// ============================================================
+// The firmware functions the modules under test call into, faked for
+// env:native. Include from exactly one file per test suite.
+// ============================================================
+#include "console.h"
+#include "scheduler.h"
+#include "timebase.h"
+#include <map>
+#include <string>
+
+uint32_t fakeNow = 1767225600UL; // 2026-01-01 00:00, a Thursday
+std::map<std::string, ConsoleHandler> fakeCommands;
+
+void consoleRegister(const char *name, ConsoleHandler fn, const char *) {
+  fakeCommands[name] = fn;
+}
+void schedulerRequestDose(int, uint8_t) {}
+void schedulerRegimenChanged(int) {}
+uint32_t timeEpoch(void) { return fakeNow; }
+
+// Runs a registered console command as if typed
+inline void fakeConsole(const char *name, const char *args) {
+  fakeCommands.at(name)(args);
+}
+
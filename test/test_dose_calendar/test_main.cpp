@@ -0,0 +1,175 @@
+#include "app_fakes.h"
+#include "dose_calendar.h"
+#include <unity.h>
+
+// ============================================================
+// Dose calendar on the host: recurrences against brute force, and the
+// heap against a linear scan through random edits
+// ============================================================
+static const uint32_t BASE = 1767225600UL; // 2026-01-01 00:00, Thursday
+
+static DoseRule rule(uint32_t start, uint32_t period, uint8_t days) {
+  DoseRule r = {};
+  r.start = start;
+  r.period = period;
+  r.days = days;
+  r.modules = 1;
+  r.slot = -1;
+  r.enabled = true;
+  return r;
+}
+
+// The first occurrence after `after` found by stepping one period at a
+// time, far past the point where the weekdays repeat
+static uint32_t bruteNext(const DoseRule &r, uint32_t after) {
+  uint32_t t = r.start;
+  if (after >= t)
+    t += ((after - t) / r.period + 1) * r.period;
+  for (int n = 0; n < 2000; n++, t += r.period)
+    if (r.days & (1 << calWeekday(t)))
+      return t;
+  return 0;
+}
+
+static void test_weekday(void) {
+  TEST_ASSERT_EQUAL(4, calWeekday(BASE)); // Thursday
+  TEST_ASSERT_EQUAL(0, calWeekday(BASE + 3 * CAL_DAILY));
+  TEST_ASSERT_EQUAL(3, calWeekday(BASE + 6 * CAL_DAILY + 86399));
+}
+
+static void test_daily_on_weekdays(void) {
+  // 08:00 Monday to Friday
+  DoseRule r = rule(8 * 3600, CAL_DAILY, 0x3E);
+  uint32_t t = BASE;
+  for (int i = 0; i < 20; i++) {
+    uint32_t next = calNextAfter(r, t);
+    TEST_ASSERT_TRUE(next > t);
+    TEST_ASSERT_EQUAL_UINT32(8 * 3600, next % CAL_DAILY);
+    TEST_ASSERT_TRUE(calWeekday(next) >= 1 && calWeekday(next) <= 5);
+    t = next;
+  }
+  // Thu 1, Fri 2, three full weeks, then Mon 26 - Wed 28
+  TEST_ASSERT_EQUAL_UINT32(BASE + 27 * CAL_DAILY + 8 * 3600, t);
+}
+
+// Periods of 1-168 h on a single weekday, every hour offset: periods
+// over a day need more than a week of steps to reach some weekdays
+static void test_periods_against_brute_force(void) {
+  int wrong = 0;
+  for (uint32_t h = 1; h <= 168; h++)
+    for (int d = 0; d < 7; d++)
+      for (uint32_t off = 0; off < h; off += (h + 7) / 8) {
+        DoseRule r = rule(BASE + off * 3600, h * 3600, 1 << d);
+        uint32_t after = BASE + 200 * 3600;
+        if (calNextAfter(r, after) != bruteNext(r, after))
+          wrong++;
+      }
+  TEST_ASSERT_EQUAL(0, wrong);
+}
+
+static void test_long_period_keeps_recurring(void) {
+  // Every 48 h, Mondays only: every 14 days
+  DoseRule r = rule(BASE, 48 * 3600, 1 << 1);
+  uint32_t t = calNextAfter(r, BASE);
+  TEST_ASSERT_EQUAL(1, calWeekday(t));
+  for (int i = 0; i < 10; i++) {
+    uint32_t next = calNextAfter(r, t);
+    TEST_ASSERT_EQUAL_UINT32(t + 14 * CAL_DAILY, next);
+    t = next;
+  }
+  // A weekday the rule can never land on
+  DoseRule never = rule(BASE, CAL_WEEK, 1 << 0);
+  TEST_ASSERT_EQUAL_UINT32(0, calNextAfter(never, BASE));
+}
+
+static void test_once(void) {
+  DoseRule r = rule(BASE + 3600, 0, CAL_EVERY_DAY);
+  TEST_ASSERT_EQUAL_UINT32(BASE + 3600, calNextAfter(r, BASE));
+  TEST_ASSERT_EQUAL_UINT32(0, calNextAfter(r, BASE + 3600));
+}
+
+// ============================================================
+// Heap
+// ============================================================
+static bool heapOk(const DoseCalendar &cal) {
+  uint32_t min = 0xFFFFFFFF;
+  int queued = 0;
+  for (int id = 0; id < cal.count; id++) {
+    const DoseRule &r = cal.rules[id];
+    if (r.pos == CAL_NONE)
+      continue;
+    queued++;
+    if (cal.heap[r.pos] != id)
+      return false;
+    if (r.pos && cal.rules[cal.heap[(r.pos - 1) / 2]].next > r.next)
+      return false;
+    min = r.next < min ? r.next : min;
+  }
+  const DoseRule *top = calPeek(cal);
+  return queued == cal.queued && (!top || top->next == min);
+}
+
+static void test_heap_random_edits(void) {
+  static DoseRule rules[200];
+  static uint16_t heap[200];
+  DoseCalendar cal;
+  calInit(cal, rules, heap, 200);
+  uint32_t now = BASE, s = 12345;
+  auto rnd = [&s]() {
+    s ^= s << 13;
+    s ^= s >> 17;
+    s ^= s << 5;
+    return s;
+  };
+  for (int i = 0; i < 50000; i++) {
+    switch (rnd() % 5) {
+    case 0:
+      if (cal.count < cal.cap) {
+        DoseRule r = rule((rnd() % 1440) * 60, (rnd() % 60 + 1) * 3600,
+                          rnd() & CAL_EVERY_DAY);
+        r.enabled = rnd() % 5 != 0;
+        calAdd(cal, r, now);
+      }
+      break;
+    case 1:
+      if (cal.count)
+        calRemove(cal, rnd() % cal.count);
+      break;
+    case 2:
+      if (cal.count) {
+        int id = rnd() % cal.count;
+        rules[id].enabled = !rules[id].enabled;
+        calUpdate(cal, id, now);
+      }
+      break;
+    case 3:
+      if (const DoseRule *top = calPeek(cal)) {
+        uint32_t due = top->next;
+        TEST_ASSERT_TRUE(due > now || due == now);
+        int id = calTake(cal);
+        TEST_ASSERT_TRUE(rules[id].next == 0 || rules[id].next > due);
+        now = due;
+      }
+      break;
+    default:
+      if (rnd() % 50 == 0)
+        calRebuild(cal, now);
+      break;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(heapOk(cal), "heap order / positions");
+  }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_weekday);
+  RUN_TEST(test_daily_on_weekdays);
+  RUN_TEST(test_periods_against_brute_force);
+  RUN_TEST(test_long_period_keeps_recurring);
+  RUN_TEST(test_once);
+  RUN_TEST(test_heap_random_edits);
+  return UNITY_END();
+}
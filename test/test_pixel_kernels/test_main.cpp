@@ -0,0 +1,112 @@
+#include "app_fakes.h"
+#include "pixel_kernels.h"
+#include <unity.h>
+
+// ============================================================
+// Pixel kernels on the host: every vector version bit for bit against
+// its scalar reference, over span lengths that exercise the tails and
+// unaligned starts, plus the blend end points
+// ============================================================
+#define SPAN_MAX 96
+#define GUARD 8 // pixels past the span that must stay untouched
+
+static uint16_t src[SPAN_MAX + 1];
+static uint8_t cover[SPAN_MAX + 1];
+static uint16_t ref[SPAN_MAX + 1 + GUARD], vec[SPAN_MAX + 1 + GUARD];
+static uint32_t seed;
+
+static uint32_t rnd(void) {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+static void seedBuffers(void) {
+  for (int i = 0; i < SPAN_MAX + 1; i++) {
+    src[i] = (uint16_t)rnd();
+    cover[i] = (uint8_t)rnd();
+  }
+  for (int i = 0; i < SPAN_MAX + 1 + GUARD; i++)
+    ref[i] = vec[i] = (uint16_t)rnd();
+}
+
+// `run(useVector, dst, off, n)` over every length and both alignments
+template <typename Run> static void compareAll(Run run) {
+  seed = 0x9E3779B9u;
+  for (int round = 0; round < 20; round++)
+    for (int off = 0; off < 2; off++)
+      for (int n = 0; n <= SPAN_MAX - off; n++) {
+        seedBuffers();
+        run(false, ref + off, off, n);
+        run(true, vec + off, off, n);
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, vec, SPAN_MAX + 1 + GUARD);
+      }
+}
+
+static void test_fill(void) {
+  compareAll([](bool v, uint16_t *dst, int, int n) {
+    (v ? pixFill : pixFillRef)(dst, 0x2652, n);
+  });
+}
+
+static void test_copy(void) {
+  compareAll([](bool v, uint16_t *dst, int off, int n) {
+    (v ? pixCopy : pixCopyRef)(dst, src + off, n);
+  });
+}
+
+static void test_copy_swap(void) {
+  compareAll([](bool v, uint16_t *dst, int off, int n) {
+    (v ? pixCopySwap : pixCopySwapRef)(dst, src + off, n);
+  });
+}
+
+static void test_blend(void) {
+  static const uint8_t alphas[] = {0, 1, 4, 100, 128, 200, 251, 255};
+  for (uint8_t a : alphas) {
+    static uint8_t alpha;
+    alpha = a;
+    compareAll([](bool v, uint16_t *dst, int off, int n) {
+      (v ? pixBlend : pixBlendRef)(dst, src + off, alpha, n);
+    });
+  }
+}
+
+static void test_blend_color(void) {
+  compareAll([](bool v, uint16_t *dst, int off, int n) {
+    (v ? pixBlendColor : pixBlendColorRef)(dst, 0xFA8A, cover + off, n);
+  });
+}
+
+// Fully opaque gives the source, fully transparent leaves the target
+static void test_blend_end_points(void) {
+  seed = 1;
+  seedBuffers();
+  uint16_t dst[SPAN_MAX];
+  memcpy(dst, ref, sizeof(dst));
+  pixBlend(dst, src, 0, SPAN_MAX);
+  TEST_ASSERT_EQUAL_HEX16_ARRAY(ref, dst, SPAN_MAX);
+  pixBlend(dst, src, 255, SPAN_MAX);
+  TEST_ASSERT_EQUAL_HEX16_ARRAY(src, dst, SPAN_MAX);
+
+  uint8_t full[SPAN_MAX];
+  memset(full, 255, sizeof(full));
+  pixBlendColor(dst, 0xFA8A, full, SPAN_MAX);
+  for (int i = 0; i < SPAN_MAX; i++)
+    TEST_ASSERT_EQUAL_HEX16(pixSwap(0xFA8A), dst[i]);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fill);
+  RUN_TEST(test_copy);
+  RUN_TEST(test_copy_swap);
+  RUN_TEST(test_blend);
+  RUN_TEST(test_blend_color);
+  RUN_TEST(test_blend_end_points);
+  return UNITY_END();
+}
@@ -0,0 +1,289 @@
+#include "app_fakes.h"
+#include "regimen.h"
+#include <unity.h>
+
+// ============================================================
+// Regimens on the host: compiler errors, pill counts and tapers, the
+// next-dose search, gap / max lockouts, and months of minutes through
+// the evaluator
+// ============================================================
+static const uint32_t DAY0 = 1767225600UL / 86400; // 2026-01-01
+
+static uint32_t at(int day, int h, int m) {
+  return (DAY0 + day) * 86400 + h * 3600 + m * 60;
+}
+
+static bool compiles(const char *src, RxCode &code) {
+  char err[64];
+  return rxCompile(src, code, err, sizeof(err));
+}
+
+static void assertError(const char *src, const char *expect) {
+  RxCode code;
+  char err[64] = "";
+  TEST_ASSERT_FALSE_MESSAGE(rxCompile(src, code, err, sizeof(err)), src);
+  TEST_ASSERT_EQUAL_STRING_MESSAGE(expect, err, src);
+  TEST_ASSERT_EQUAL_UINT8(0, code.len);
+}
+
+// ============================================================
+// Compiler
+// ============================================================
+static void test_compile_accepts(void) {
+  static const char *ok[] = {
+      "at 08:00",
+      "at 08:00,20:00; for 10d; pills 2",
+      "at 08:00 ; every 2d ; for 10d ",
+      "taper 4,3,2,1/5d; at 08:00",
+      "taper 1,1,1,1,1,1,1,1/2d; at 08:00",
+      "prn; gap 4h; max 3/24h",
+      "at 08:00,20:00; prn; gap 90m; max 4/1d",
+      ";; at 08:00;",
+  };
+  for (const char *src : ok) {
+    RxCode code;
+    TEST_ASSERT_TRUE_MESSAGE(compiles(src, code), src);
+    TEST_ASSERT_TRUE(code.len > 0 && code.len <= RX_CODE_MAX);
+  }
+}
+
+static void test_compile_rejects_trailing_text(void) {
+  assertError("prn; gap 4h30m", "unexpected text (at 11)");
+  assertError("prn; max 3/24h junk", "unexpected text (at 15)");
+  assertError("at 08:00; pills 2 tablets", "unexpected text (at 18)");
+  assertError("at 08:00 daily", "unexpected text (at 9)");
+  assertError("prn now", "unexpected text (at 4)");
+}
+
+static void test_compile_rejects_bad_clauses(void) {
+  assertError("", "needs dose times (at) or prn");
+  assertError("for 10d", "needs dose times (at) or prn");
+  assertError("prnx", "unknown clause (at 0)");
+  assertError("at 24:00", "at: HH:MM, up to 6 times (at 0)");
+  assertError("at noon", "at: HH:MM[,HH:MM...] (at 0)");
+  assertError("at 08:00; every 2", "every: 1d-255d (at 10)");
+  assertError("prn; gap 4", "gap: Nh or Nm, up to 7d (at 5)");
+  assertError("prn; max 9/24h", "max: N/Nh, N up to 8, up to 7d (at 5)");
+  assertError("at 08:00; pills 0", "pills: 1-9 (at 10)");
+}
+
+static void test_compile_rejects_long_source(void) {
+  char src[RX_SRC_MAX + 8];
+  strcpy(src, "prn; gap 4h");
+  while (strlen(src) < RX_SRC_MAX - 1)
+    strcat(src, " ");
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles(src, code)); // 63 characters: fits
+  strcat(src, ";");
+  assertError(src, "longer than 63 characters");
+}
+
+static void test_compile_taper_errors(void) {
+  assertError("taper 1,1,1,1,1,1,1,1,1/2d; at 08:00",
+              "taper: up to 8 steps (at 0)");
+  assertError("taper 12,3/2d; at 08:00", "taper: 1-9 pills per step (at 0)");
+  assertError("at 08:00; pills 2; taper 2,1/3d",
+              "taper: not with pills (at 19)");
+  assertError("at 08:00; taper 2,1/3d; pills 2",
+              "pills: not with taper (at 24)");
+  assertError("at 08:00; taper 2,1", "taper: n,n,.../Nd, step 1d-255d (at 10)");
+}
+
+// ============================================================
+// Evaluation
+// ============================================================
+static void test_pills_at_dose_minutes(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("at 20:00,08:00; pills 2", code));
+  TEST_ASSERT_EQUAL(2, rxPillsAt(code, DAY0, at(0, 8, 0)));
+  TEST_ASSERT_EQUAL(2, rxPillsAt(code, DAY0, at(0, 20, 0) + 59));
+  TEST_ASSERT_EQUAL(0, rxPillsAt(code, DAY0, at(0, 8, 1)));
+  TEST_ASSERT_EQUAL(0, rxPillsAt(code, DAY0, at(-1, 8, 0))); // before day 0
+}
+
+static void test_taper_steps(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("taper 4,3,2,1/5d; at 08:00", code));
+  static const int expect[] = {4, 4, 4, 4, 4, 3, 3, 3, 3, 3,
+                               2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 0, 0};
+  for (int d = 0; d < 22; d++)
+    TEST_ASSERT_EQUAL_MESSAGE(expect[d], rxPillsAt(code, DAY0, at(d, 8, 0)),
+                              "taper day");
+  // The course ends after the last step
+  TEST_ASSERT_EQUAL_UINT32(at(19, 8, 0), rxNextDue(code, DAY0, at(18, 9, 0)));
+  TEST_ASSERT_EQUAL_UINT32(0, rxNextDue(code, DAY0, at(19, 8, 0)));
+}
+
+static void test_every_other_day_course(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("at 08:00,20:00; every 2d; for 10d", code));
+  int doses = 0;
+  uint32_t t = at(0, 0, 0);
+  while ((t = rxNextDue(code, DAY0, t)) != 0) {
+    int day = t / 86400 - DAY0;
+    TEST_ASSERT_EQUAL(0, day % 2);
+    TEST_ASSERT_TRUE(day < 10);
+    TEST_ASSERT_EQUAL(1, rxPillsAt(code, DAY0, t));
+    doses++;
+  }
+  TEST_ASSERT_EQUAL(10, doses); // days 0, 2, 4, 6, 8, twice each
+}
+
+// rxNextDue() agrees with a minute-by-minute scan of rxPillsAt()
+static void test_next_due_matches_scan(void) {
+  static const char *srcs[] = {
+      "at 08:00,13:30,20:00",
+      "at 07:15; every 3d; for 40d; pills 2",
+      "taper 3,2,1/4d; at 08:00,20:00",
+      "at 23:59; every 5d",
+  };
+  for (const char *src : srcs) {
+    RxCode code;
+    TEST_ASSERT_TRUE_MESSAGE(compiles(src, code), src);
+    uint32_t next = rxNextDue(code, DAY0, at(0, 0, 0) - 1);
+    for (uint32_t t = at(0, 0, 0); t < at(60, 0, 0); t += 60) {
+      if (!rxPillsAt(code, DAY0, t))
+        continue;
+      TEST_ASSERT_EQUAL_UINT32_MESSAGE(t, next, src);
+      next = rxNextDue(code, DAY0, t);
+    }
+    TEST_ASSERT_TRUE_MESSAGE(next == 0 || next >= at(60, 0, 0), src);
+  }
+}
+
+// ============================================================
+// Lockouts
+// ============================================================
+static void test_gap_lockout(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("prn; gap 4h", code));
+  uint32_t t = at(3, 12, 0);
+  uint32_t hist[] = {t - 3 * 3600};
+  TEST_ASSERT_EQUAL_UINT32(3600, rxLockout(code, hist, 1, t));
+  TEST_ASSERT_EQUAL_UINT32(0, rxLockout(code, hist, 1, t + 3600));
+  TEST_ASSERT_EQUAL_UINT32(0, rxLockout(code, hist, 0, t));
+}
+
+static void test_max_lockout(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("prn; max 3/24h", code));
+  uint32_t t = at(3, 12, 0);
+  uint32_t hist[] = {t - 3600, t - 2 * 3600, t - 23 * 3600, t - 30 * 3600};
+  // Three in the last 24 h: free once the oldest of them is 24 h old
+  TEST_ASSERT_EQUAL_UINT32(3600, rxLockout(code, hist, 4, t));
+  TEST_ASSERT_EQUAL_UINT32(0, rxLockout(code, hist, 4, t + 3600));
+  TEST_ASSERT_EQUAL_UINT32(0, rxLockout(code, hist, 2, t));
+}
+
+static void test_gap_and_max_take_the_longer(void) {
+  RxCode code;
+  TEST_ASSERT_TRUE(compiles("prn; gap 2h; max 2/12h", code));
+  uint32_t t = at(3, 12, 0);
+  uint32_t hist[] = {t - 3600, t - 6 * 3600};
+  TEST_ASSERT_EQUAL_UINT32(6 * 3600, rxLockout(code, hist, 2, t));
+  uint32_t hist2[] = {t - 3600, t - 11 * 3600 - 1800};
+  TEST_ASSERT_EQUAL_UINT32(3600, rxLockout(code, hist2, 2, t));
+}
+
+// Months of minutes: scheduled doses are taken unless locked out, PRN is
+// asked every 20 min; every dose taken is checked against gap and max
+// over the full record, independently of rxLockout()
+static void test_months_of_minutes(void) {
+  static const struct {
+    const char *src;
+    uint32_t gapS;
+    int maxN;
+    uint32_t windowS;
+  } cases[] = {
+      {"at 08:00,20:00; prn; gap 4h; max 3/24h", 4 * 3600, 3, 86400},
+      {"prn; gap 90m; max 8/2d", 90 * 60, 8, 2 * 86400},
+      {"at 06:00,12:00,18:00; gap 5h", 5 * 3600, 0, 0},
+      {"taper 4,3,2,1/30d; at 08:00; prn; max 2/24h", 0, 2, 86400},
+  };
+  const int days = 120;
+  for (const auto &c : cases) {
+    const char *src = c.src;
+    RxCode code;
+    TEST_ASSERT_TRUE_MESSAGE(compiles(src, code), src);
+    uint32_t hist[RX_HISTORY];
+    int histLen = 0;
+    static uint32_t taken[days * 24 * 3];
+    int n = 0;
+    bool prn = strstr(src, "prn") != nullptr;
+    for (uint32_t t = at(0, 0, 0); t < at(days, 0, 0); t += 60) {
+      bool due = rxPillsAt(code, DAY0, t) > 0;
+      bool ask = prn && (t / 60) % 20 == 0;
+      if ((!due && !ask) || rxLockout(code, hist, histLen, t))
+        continue;
+      if (c.gapS && n)
+        TEST_ASSERT_TRUE_MESSAGE(t - taken[n - 1] >= c.gapS, src);
+      if (c.maxN) {
+        int inWindow = 1;
+        for (int i = n - 1; i >= 0 && t - taken[i] < c.windowS; i--)
+          inWindow++;
+        TEST_ASSERT_TRUE_MESSAGE(inWindow <= c.maxN, src);
+      }
+      taken[n++] = t;
+      memmove(&hist[1], &hist[0], (RX_HISTORY - 1) * sizeof(uint32_t));
+      hist[0] = t;
+      histLen += histLen < RX_HISTORY;
+    }
+    TEST_ASSERT_TRUE_MESSAGE(n > days, src); // doses did go out
+  }
+}
+
+// ============================================================
+// Per-module regimens through `rx`
+// ============================================================
+static void test_module_regimen(void) {
+  rxSetup();
+  fakeNow = at(0, 7, 0);
+  fakeConsole("rx", "2 at 08:00,20:00; pills 2; prn; gap 4h");
+  TEST_ASSERT_TRUE(rxActive(1));
+  TEST_ASSERT_TRUE(rxHasPrn(1));
+  TEST_ASSERT_FALSE(rxActive(0));
+  TEST_ASSERT_EQUAL(2, rxPills(1, at(0, 8, 0)));
+  TEST_ASSERT_EQUAL_UINT32(at(0, 8, 0), rxNext(1, fakeNow));
+
+  rxRecord(1, at(0, 8, 0));
+  TEST_ASSERT_EQUAL_UINT32(3600, rxWait(1, at(0, 11, 0)));
+
+  // A rejected regimen leaves the old one in place
+  fakeConsole("rx", "2 prn; gap 4h30m");
+  TEST_ASSERT_EQUAL(2, rxPills(1, at(1, 8, 0)));
+
+  // A new regimen keeps the dose history
+  fakeConsole("rx", "2 prn; gap 6h");
+  TEST_ASSERT_EQUAL_UINT32(3 * 3600, rxWait(1, at(0, 11, 0)));
+  TEST_ASSERT_EQUAL_UINT32(0, rxNext(1, fakeNow));
+
+  // ...and survives a reload from NVS
+  rxSetup();
+  TEST_ASSERT_EQUAL_UINT32(3 * 3600, rxWait(1, at(0, 11, 0)));
+
+  fakeConsole("rx", "2 off");
+  TEST_ASSERT_FALSE(rxActive(1));
+  TEST_ASSERT_EQUAL_UINT32(0, rxWait(1, at(0, 11, 0)));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int, char **) {
+  UNITY_BEGIN();
+  RUN_TEST(test_compile_accepts);
+  RUN_TEST(test_compile_rejects_trailing_text);
+  RUN_TEST(test_compile_rejects_bad_clauses);
+  RUN_TEST(test_compile_rejects_long_source);
+  RUN_TEST(test_compile_taper_errors);
+  RUN_TEST(test_pills_at_dose_minutes);
+  RUN_TEST(test_taper_steps);
+  RUN_TEST(test_every_other_day_course);
+  RUN_TEST(test_next_due_matches_scan);
+  RUN_TEST(test_gap_lockout);
+  RUN_TEST(test_max_lockout);
+  RUN_TEST(test_gap_and_max_take_the_longer);
+  RUN_TEST(test_months_of_minutes);
+  RUN_TEST(test_module_regimen);
+  return UNITY_END();
+}
@@ -0,0 +1,52 @@
+#pragma once
+// ============================================================
+// RGB565 frames to and from PNG (libpng's simplified API). RGB565 is
+// widened to 8 bits per channel by bit replication, so a frame read
+// back narrows to exactly the pixels that were written.
+// ============================================================
+#include <cstdint>
+#include <png.h>
+#include <string>
+#include <vector>
+
+struct Frame {
+  int w = 0, h = 0;
+  std::vector<uint16_t> px; // RGB565, row-major
+};
+
+inline bool pngWrite(const std::string &path, const Frame &f) {
+  std::vector<uint8_t> rgb(f.px.size() * 3);
+  for (size_t i = 0; i < f.px.size(); i++) {
+    uint16_t c = f.px[i];
+    uint8_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    rgb[i * 3] = r << 3 | r >> 2;
+    rgb[i * 3 + 1] = g << 2 | g >> 4;
+    rgb[i * 3 + 2] = b << 3 | b >> 2;
+  }
+  png_image img = {};
+  img.version = PNG_IMAGE_VERSION;
+  img.width = f.w;
+  img.height = f.h;
+  img.format = PNG_FORMAT_RGB;
+  return png_image_write_to_file(&img, path.c_str(), 0, rgb.data(), 0,
+                                 nullptr) != 0;
+}
+
+// False if the file is missing or not a PNG
+inline bool pngRead(const std::string &path, Frame &f) {
+  png_image img = {};
+  img.version = PNG_IMAGE_VERSION;
+  if (!png_image_begin_read_from_file(&img, path.c_str()))
+    return false;
+  img.format = PNG_FORMAT_RGB;
+  std::vector<uint8_t> rgb(PNG_IMAGE_SIZE(img));
+  if (!png_image_finish_read(&img, nullptr, rgb.data(), 0, nullptr))
+    return false;
+  f.w = img.width;
+  f.h = img.height;
+  f.px.resize((size_t)f.w * f.h);
+  for (size_t i = 0; i < f.px.size(); i++)
+    f.px[i] = (rgb[i * 3] >> 3) << 11 | (rgb[i * 3 + 1] >> 2) << 5 |
+              rgb[i * 3 + 2] >> 3;
+  return true;
+}
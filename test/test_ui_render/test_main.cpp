@@ -0,0 +1,214 @@
+#include "golden_png.h"
+#include "ui_fakes.h"
+#include "ui_manager.h"
+#include <chrono>
+#include <sys/stat.h>
+#include <unity.h>
+
+// ============================================================
+// Every screen rendered on the host and compared with its reference PNG
+// in golden/ (next to this file), plus the cost of drawing each one.
+//   no golden yet        it is written and the test is ignored: look at
+//                        the image, then commit it
+//   UI_GOLDEN_UPDATE=1   rewrites every golden and the cost baseline
+//   mismatch             <screen>.actual.png and <screen>.diff.png
+//                        (changed pixels in red) are written beside it
+// ============================================================
+#define COST_RUNS 50      // renders per screen, full and cached
+#define COST_SLACK 2      // fail when a screen is this many times slower
+#define COST_FLOOR_US 500 // than its baseline, and slower than this
+
+static const char *const screenFiles[SCREEN_COUNT] = {
+    "home",          "schedule",         "time_picker",
+    "modules",       "module_detail",    "manual_dispense",
+    "confirm",       "wifi_menu",        "wifi_scan",
+    "wifi_osk",      "wifi_portal",      "dispensing",
+    "result"};
+
+static std::string goldenDir(void) {
+  std::string f = __FILE__;
+  return f.substr(0, f.find_last_of('/') + 1) + "golden/";
+}
+
+static bool updating(void) {
+  const char *e = getenv("UI_GOLDEN_UPDATE");
+  return e && *e && strcmp(e, "0") != 0;
+}
+
+static Frame grab(void) {
+  Frame f;
+  f.w = LCD_WIDTH;
+  f.h = LCD_HEIGHT;
+  f.px.resize(LCD_WIDTH * LCD_HEIGHT);
+  for (int y = 0; y < LCD_HEIGHT; y++)
+    for (int x = 0; x < LCD_WIDTH; x++)
+      f.px[y * LCD_WIDTH + x] = uiCanvasPixel(x, y);
+  return f;
+}
+
+// Golden dimmed to grey, changed pixels red; returns how many changed
+// and their bounding box
+static int diffFrames(const Frame &want, const Frame &got, Frame &diff,
+                      int box[4]) {
+  diff = want;
+  int n = 0;
+  box[0] = box[1] = 1 << 30;
+  box[2] = box[3] = -1;
+  for (int y = 0; y < want.h; y++)
+    for (int x = 0; x < want.w; x++) {
+      int i = y * want.w + x;
+      if (want.px[i] == got.px[i]) {
+        uint16_t g = (want.px[i] >> 6) & 0x1F; // green, as 5 bits
+        uint16_t grey = 16 + g / 2;
+        diff.px[i] = grey << 11 | grey << 6 | grey;
+        continue;
+      }
+      diff.px[i] = 0xF800;
+      n++;
+      box[0] = x < box[0] ? x : box[0];
+      box[1] = y < box[1] ? y : box[1];
+      box[2] = x > box[2] ? x : box[2];
+      box[3] = y > box[3] ? y : box[3];
+    }
+  return n;
+}
+
+static void checkScreen(Screen s) {
+  TEST_ASSERT_TRUE(uiRenderBegin());
+  uiRender(s, true);
+  Frame full = grab();
+  uiRender(s, false); // over the static layer cached by the full render
+  Frame cached = grab();
+  uiRenderEnd();
+
+  static char msg[200];
+  Frame diff;
+  int box[4];
+  int changed = diffFrames(full, cached, diff, box);
+  snprintf(msg, sizeof(msg), "cached render differs from full: %d px", changed);
+  TEST_ASSERT_EQUAL_MESSAGE(0, changed, msg);
+
+  std::string base = goldenDir() + screenFiles[s];
+  Frame golden;
+  if (updating() || !pngRead(base + ".png", golden)) {
+    mkdir(goldenDir().c_str(), 0755);
+    TEST_ASSERT_TRUE_MESSAGE(pngWrite(base + ".png", full), "PNG write");
+    if (!updating())
+      TEST_IGNORE_MESSAGE("no golden yet: written, review it and commit it");
+    return;
+  }
+  TEST_ASSERT_EQUAL(full.w, golden.w);
+  TEST_ASSERT_EQUAL(full.h, golden.h);
+  changed = diffFrames(golden, full, diff, box);
+  if (changed) {
+    pngWrite(base + ".actual.png", full);
+    pngWrite(base + ".diff.png", diff);
+    snprintf(msg, sizeof(msg), "%d px differ in (%d,%d)-(%d,%d), see %s",
+             changed, box[0], box[1], box[2], box[3],
+             (base + ".diff.png").c_str());
+    TEST_FAIL_MESSAGE(msg);
+  }
+}
+
+#define SCREEN_TEST(name, screen)                                           \
+  static void test_##name(void) { checkScreen(screen); }
+SCREEN_TEST(home, SCREEN_HOME)
+SCREEN_TEST(schedule, SCREEN_SCHEDULE)
+SCREEN_TEST(time_picker, SCREEN_TIME_PICKER)
+SCREEN_TEST(modules, SCREEN_MODULES)
+SCREEN_TEST(module_detail, SCREEN_MODULE_DETAIL)
+SCREEN_TEST(manual_dispense, SCREEN_MANUAL_DISPENSE)
+SCREEN_TEST(confirm, SCREEN_CONFIRM_DISPENSE)
+SCREEN_TEST(wifi_menu, SCREEN_WIFI_MENU)
+SCREEN_TEST(wifi_scan, SCREEN_WIFI_SCAN)
+SCREEN_TEST(wifi_osk, SCREEN_WIFI_OSK)
+SCREEN_TEST(wifi_portal, SCREEN_WIFI_PORTAL)
+SCREEN_TEST(dispensing, SCREEN_DISPENSING)
+SCREEN_TEST(result, SCREEN_RESULT)
+
+// ============================================================
+// Render cost: fastest of COST_RUNS full (static layer dropped) and
+// cached renders per screen, against golden/render_cost.txt
+// ============================================================
+static double renderUs(Screen s, bool full) {
+  using namespace std::chrono;
+  double best = 1e12;
+  for (int i = 0; i < COST_RUNS; i++) {
+    steady_clock::time_point t = steady_clock::now();
+    uiRender(s, full);
+    double us = duration<double, std::micro>(steady_clock::now() - t).count();
+    best = us < best ? us : best;
+  }
+  return best;
+}
+
+static void test_render_cost(void) {
+  double full[SCREEN_COUNT], cached[SCREEN_COUNT];
+  TEST_ASSERT_TRUE(uiRenderBegin());
+  for (int i = 0; i < SCREEN_COUNT; i++) {
+    full[i] = renderUs((Screen)i, true);
+    cached[i] = renderUs((Screen)i, false);
+  }
+  uiRenderEnd();
+
+  for (int i = 0; i < SCREEN_COUNT; i++)
+    printf("  %-16s full %7.0f us  cached %7.0f us\n", screenFiles[i],
+           full[i], cached[i]);
+
+  std::string path = goldenDir() + "render_cost.txt";
+  FILE *f = updating() ? nullptr : fopen(path.c_str(), "r");
+  if (!f) {
+    mkdir(goldenDir().c_str(), 0755);
+    f = fopen(path.c_str(), "w");
+    TEST_ASSERT_NOT_NULL(f);
+    for (int i = 0; i < SCREEN_COUNT; i++)
+      fprintf(f, "%s %.0f %.0f\n", screenFiles[i], full[i], cached[i]);
+    fclose(f);
+    if (!updating())
+      TEST_IGNORE_MESSAGE("no cost baseline yet: written, commit it");
+    return;
+  }
+
+  static char msg[200];
+  strcpy(msg, "slower than render_cost.txt:");
+  size_t clean = strlen(msg);
+  char name[32];
+  double was[2];
+  while (fscanf(f, "%31s %lf %lf", name, &was[0], &was[1]) == 3)
+    for (int i = 0; i < SCREEN_COUNT; i++) {
+      if (strcmp(name, screenFiles[i]) != 0)
+        continue;
+      double now[2] = {full[i], cached[i]};
+      for (int k = 0; k < 2; k++)
+        if (now[k] > COST_SLACK * was[k] && now[k] > COST_FLOOR_US &&
+            strlen(msg) + strlen(name) + 10 < sizeof(msg))
+          strcat(strcat(strcat(msg, " "), name), k ? "/cached" : "/full");
+    }
+  fclose(f);
+  if (strlen(msg) > clean)
+    TEST_FAIL_MESSAGE(msg);
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int, char **) {
+  fakeClock = true; // the confirm countdown renders the same every run
+  uiSetup();
+  UNITY_BEGIN();
+  RUN_TEST(test_home);
+  RUN_TEST(test_schedule);
+  RUN_TEST(test_time_picker);
+  RUN_TEST(test_modules);
+  RUN_TEST(test_module_detail);
+  RUN_TEST(test_manual_dispense);
+  RUN_TEST(test_confirm);
+  RUN_TEST(test_wifi_menu);
+  RUN_TEST(test_wifi_scan);
+  RUN_TEST(test_wifi_osk);
+  RUN_TEST(test_wifi_portal);
+  RUN_TEST(test_dispensing);
+  RUN_TEST(test_result);
+  RUN_TEST(test_render_cost);
+  return UNITY_END();
+}
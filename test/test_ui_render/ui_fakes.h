@@ -0,0 +1,81 @@
+#pragma once
+// ============================================================
+// The firmware the UI calls into, faked for the host render tests: a
+// fixed clock, schedule and module set, no Wi-Fi, an idle servo and a
+// display that keeps the canvas in memory. Include from test_main.cpp
+// only.
+// ============================================================
+#include "app_fakes.h"
+#include "display_module.h"
+#include "dirty_rect.h"
+#include "power.h"
+#include "servo_control.h"
+#include "touch_input.h"
+#include "wifi_manager.h"
+
+// --- Display: the canvas is the frame, nothing is pushed ---
+void displayFramesSetup(LGFX_Sprite &canvas) {
+  canvas.createSprite(LCD_WIDTH, LCD_HEIGHT);
+}
+void displayPresent(LGFX_Sprite &) { dirtyClear(); }
+bool displayBusy(void) { return false; }
+void displayWait(void) {}
+void displaySetPalette(const uint16_t *, int) {}
+
+// --- Scheduler: Thursday 2026-01-01 08:30:00, next dose at 12:00 ---
+static TimeSlot fakeSlots[NUM_TIME_SLOTS] = {
+    {7, 30, true},  {8, 0, true},   {11, 30, false}, {12, 0, true},
+    {17, 30, true}, {18, 0, false}, {21, 0, true}};
+static MedModule fakeModules[NUM_MODULES] = {
+    {"Paracetamol", 20, 0x0A}, {"Vitamin C", 30, 0x02},
+    {"Antacid", 12, 0x08},     {"Allergy", 8, 0x40},
+    {"", 0, 0},                {"", 0, 0}};
+static bool fakeEnabled = true;
+
+TimeSlot &timeSlotGet(int index) { return fakeSlots[index]; }
+void timeSlotSet(int index, uint8_t h, uint8_t m, bool en) {
+  fakeSlots[index] = {h, m, en};
+}
+MedModule &moduleGet(int index) { return fakeModules[index]; }
+void moduleSetName(int index, const char *name) {
+  snprintf(fakeModules[index].name, MAX_MED_NAME, "%s", name);
+}
+void moduleToggleSlot(int index, int slotBit) {
+  fakeModules[index].slotMask ^= 1 << slotBit;
+}
+void schedulerSave(void) {}
+void schedulerGetTime(uint8_t &h, uint8_t &m, uint8_t &s) {
+  h = 8;
+  m = 30;
+  s = 0;
+}
+void schedulerGetDate(uint16_t &year, uint8_t &month, uint8_t &day,
+                      uint8_t &dow) {
+  year = 2026;
+  month = 1;
+  day = 1;
+  dow = 4;
+}
+bool schedulerNextDose(uint32_t &at, int &slot, uint8_t &modules) {
+  at = fakeNow + 12 * 3600;
+  slot = 3;
+  modules = 0x05;
+  return true;
+}
+bool schedulerIsEnabled(void) { return fakeEnabled; }
+void schedulerSetEnabled(bool en) { fakeEnabled = en; }
+
+// --- Wi-Fi, servo, power, touch: idle and disconnected ---
+bool wifiIsConnected(void) { return false; }
+String wifiGetSSID(void) { return String(); }
+void wifiStartPortal(void) {}
+void wifiConnectManual(const char *, const char *) {}
+void wifiForget(void) {}
+
+bool servoIsBusy(void) { return false; }
+void servoToggleManual(int) {}
+bool servoIsManualActive(int) { return false; }
+
+PowerState powerState(void) { return POWER_ACTIVE; }
+bool powerTouch(const TouchEvent &) { return false; }
+bool touchNext(TouchEvent &) { return false; }